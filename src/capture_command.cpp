@@ -0,0 +1,254 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef LINUX_BUILD
+#include "capture_command.h"
+#include "timeline.h"
+#include "serial_port.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <vector>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <boost/program_options/errors.hpp>
+using namespace std;
+namespace po = boost::program_options;
+namespace command_line
+{
+	static volatile sig_atomic_t interrupted = 0;
+	static void onInterrupt(int)
+	{
+		interrupted = 1;
+	}
+	static bool writeAll(int fd, const string &data)
+	{
+		size_t offset = 0;
+		while (offset < data.size()){
+			ssize_t wrote = ::write(fd, data.data() + offset, data.size() - offset);
+			if (wrote < 0){
+				if (errno == EINTR) continue;
+				return false;
+			}
+			offset += wrote;
+		}
+		return true;
+	}
+	struct GpioSample
+	{
+		uint64_t time_us;
+		uint8_t value;
+	};
+	struct GpioSampler
+	{
+		GpioSampler(mcp2200::Device &device, chrono::steady_clock::time_point start, chrono::milliseconds interval, uint8_t mask):
+			m_device(device),
+			m_start(start),
+			m_interval(interval),
+			m_mask(mask),
+			m_last_time(0),
+			m_samples(0),
+			m_stop(false),
+			m_failed(false)
+		{
+		}
+		void run()
+		{
+			using clock = chrono::steady_clock;
+			mcp2200::Command response;
+			uint8_t last_value = 0;
+			bool first = true;
+			auto next_sample = clock::now();
+			while (!m_stop){
+				auto before = clock::now();
+				if (!m_device.readAll(response)){
+					m_failed = true;
+					break;
+				}
+				auto after = clock::now();
+				// Sample time is the middle of the request, which is closer to the moment the device read its pins than either end.
+				uint64_t time_us = chrono::duration_cast<chrono::microseconds>(before + (after - before) / 2 - m_start).count();
+				uint8_t value = response.getGpioValues() & m_mask;
+				{
+					lock_guard<mutex> lock(m_mutex);
+					if (first || value != last_value)
+						m_pending.push_back(GpioSample{time_us, value});
+					m_last_time = time_us;
+					m_samples++;
+				}
+				first = false;
+				last_value = value;
+				if (m_interval.count() > 0){
+					next_sample += m_interval;
+					if (next_sample > after){
+						this_thread::sleep_until(next_sample);
+					}else{
+						next_sample = after;
+					}
+				}
+			}
+		}
+		void collect(Timeline &timeline)
+		{
+			lock_guard<mutex> lock(m_mutex);
+			for (auto &sample: m_pending)
+				timeline.addGpio(sample.time_us, sample.value);
+			m_pending.clear();
+			timeline.advance(TimelineSource::gpio, m_last_time);
+		}
+		void stop()
+		{
+			m_stop = true;
+		}
+		bool isFailed() const
+		{
+			return m_failed;
+		}
+		uint64_t getSamples()
+		{
+			lock_guard<mutex> lock(m_mutex);
+			return m_samples;
+		}
+		private:
+		mcp2200::Device &m_device;
+		chrono::steady_clock::time_point m_start;
+		chrono::milliseconds m_interval;
+		uint8_t m_mask;
+		mutex m_mutex;
+		vector<GpioSample> m_pending;
+		uint64_t m_last_time, m_samples;
+		atomic<bool> m_stop, m_failed;
+	};
+	CaptureCommand::CaptureCommand():
+		DeviceCommand("capture", "record received serial data and GPIO changes on one timeline")
+	{
+	}
+	CaptureCommand::~CaptureCommand()
+	{
+	}
+	void CaptureCommand::addOptions(po::options_description &options, po::options_description &hidden_options)
+	{
+		using namespace boost::program_options;
+		DeviceCommand::addOptions(options, hidden_options);
+		m_serial_target.addOptions(options, hidden_options);
+		options.add_options()
+			("interval,i", po::value<int>(&m_interval)->default_value(1)->notifier([](int value){ if (value < 0) throw validation_error(validation_error::invalid_option_value, "interval", to_string(value)); }), "GPIO sampling interval in milliseconds (0 samples as fast as possible)")
+			("mask,m", po::value<BitMap<uint8_t>>(&m_mask)->default_value(BitMap<uint8_t>(0xff), "11111111"), "GPIO pins to watch")
+			("format,f", po::value<SampleFormat>(&m_format)->default_value(SampleFormat::text), "output format (text, csv, ndjson or binary)")
+			("output,o", po::value<string>(&m_output)->default_value("-"), "write timeline to this file (- for standard output)")
+			("duration,d", po::value<double>(&m_duration)->default_value(0), "stop after this many seconds (0 to run until interrupted)")
+		;
+	}
+	bool CaptureCommand::checkOptions(po::variables_map &variable_map)
+	{
+		if (!DeviceCommand::checkOptions(variable_map)) return false;
+		return m_serial_target.checkOptions(variable_map);
+	}
+	bool CaptureCommand::run(mcp2200::Device &device)
+	{
+		using clock = chrono::steady_clock;
+		const auto flush_interval = chrono::milliseconds(50);
+		mcp2200::SerialPort port;
+		if (!m_serial_target.open(m_target, device, port)){
+			return false;
+		}
+		int output_fd = m_output == "-" ? STDOUT_FILENO : ::open(m_output.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+		if (output_fd < 0){
+			cerr << "could not open output (" << m_output << ")\n";
+			return false;
+		}
+		Timeline timeline(m_format);
+		string output;
+		vector<uint8_t> buffer(64 * 1024);
+		uint64_t uart_bytes = 0, events = 0;
+		bool result = true;
+		interrupted = 0;
+		auto previous_handler = signal(SIGINT, onInterrupt);
+		auto start = clock::now(), last_flush = start;
+		auto end = start + chrono::duration_cast<clock::duration>(chrono::duration<double>(m_duration));
+		// GPIO values are read on a separate thread, so slow HID requests do not delay serial data timestamps.
+		GpioSampler sampler(device, start, chrono::milliseconds(m_interval), m_mask);
+		thread sampler_thread(&GpioSampler::run, &sampler);
+		while (!interrupted && !sampler.isFailed()){
+			auto now = clock::now();
+			if (m_duration > 0 && now >= end) break;
+			auto wait = chrono::duration_cast<chrono::milliseconds>(last_flush + flush_interval - now).count();
+			pollfd fds = {port.getFd(), POLLIN, 0};
+			int ready = poll(&fds, 1, static_cast<int>(max<decltype(wait)>(wait, 0)));
+			if (ready < 0 && errno != EINTR){
+				result = false;
+				break;
+			}
+			now = clock::now();
+			uint64_t time_us = chrono::duration_cast<chrono::microseconds>(now - start).count();
+			if (ready > 0){
+				ssize_t count = ::read(port.getFd(), buffer.data(), buffer.size());
+				if (count <= 0 && !(count < 0 && (errno == EAGAIN || errno == EINTR))){
+					cerr << "could not read serial port\n";
+					result = false;
+					break;
+				}
+				if (count > 0){
+					timeline.addUart(time_us, buffer.data(), count);
+					uart_bytes += count;
+				}
+			}
+			timeline.advance(TimelineSource::uart, time_us);
+			if (now - last_flush >= flush_interval){
+				sampler.collect(timeline);
+				events += timeline.merge(output);
+				if (!output.empty() && !writeAll(output_fd, output)){
+					result = false;
+					break;
+				}
+				output.clear();
+				last_flush = now;
+			}
+		}
+		sampler.stop();
+		sampler_thread.join();
+		signal(SIGINT, previous_handler);
+		if (sampler.isFailed()){
+			cerr << "could not read GPIO values\n";
+			result = false;
+		}
+		sampler.collect(timeline);
+		events += timeline.finish(output);
+		if (!writeAll(output_fd, output)) result = false;
+		if (output_fd > STDOUT_FILENO) ::close(output_fd);
+		double seconds = chrono::duration<double>(clock::now() - start).count();
+		ostream_state_saver state(cerr);
+		cerr << events << " events, " << uart_bytes << " serial bytes, " << sampler.getSamples() << " GPIO samples in " << fixed << setprecision(3) << seconds << " s";
+		if (seconds > 0)
+			cerr << " (" << setprecision(1) << sampler.getSamples() / seconds << " samples/s)";
+		cerr << "\n";
+		return result;
+	}
+}
+#endif
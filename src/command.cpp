@@ -67,6 +67,10 @@ namespace command_line
 	{
 		return false;
 	}
+	bool Command::runsInterpreter() const
+	{
+		return false;
+	}
 	void Command::addAlias(const char *alias)
 	{
 		m_aliases.push_back(alias);
@@ -43,6 +43,8 @@ namespace command_line
 		virtual void addPositionalOptions(boost::program_options::positional_options_description &positional_options);
 		virtual bool checkOptions(boost::program_options::variables_map &variable_map);
 		virtual bool run();
+		// Commands running other command lines, these can not be nested because command instances are shared.
+		virtual bool runsInterpreter() const;
 		void addAlias(const char *alias);
 		const std::vector<std::string>& getAliases() const;
 		private:
@@ -55,7 +55,7 @@ namespace mcp2200
 namespace command_line
 {
 	ConfigureCommand::ConfigureCommand():
-		Command("configure", "get or set device configuration")
+		DeviceCommand("configure", "get or set device configuration")
 	{
 	}
 	ConfigureCommand::~ConfigureCommand()
@@ -63,7 +63,7 @@ namespace command_line
 	}
 	void ConfigureCommand::addOptions(po::options_description &options, po::options_description &hidden_options)
 	{
-		m_target.addOptions(options, hidden_options);
+		DeviceCommand::addOptions(options, hidden_options);
 		options.add_options()
 			("direction,d", po::value<BitMap<uint8_t>>(&m_direction), "GPIO directions (use i and o symbols)")
 			("default,g", po::value<BitMap<uint8_t>>(&m_default), "default GPIO values")
@@ -78,7 +78,7 @@ namespace command_line
 	}
 	bool ConfigureCommand::checkOptions(po::variables_map &variable_map)
 	{
-		if (!m_target.checkOptions(variable_map)) return false;
+		if (!DeviceCommand::checkOptions(variable_map)) return false;
 		m_direction_set = variable_map.count("direction") > 0;
 		m_default_set = variable_map.count("default") > 0;
 		m_rx_led_set = variable_map.count("rxled") > 0;
@@ -91,45 +91,40 @@ namespace command_line
 		m_print = !(m_direction_set || m_default_set || m_rx_led_set || m_tx_led_set || m_invert_set || m_suspend_set || m_configuration_set || m_flow_control_set | m_blink_speed_set);
 		return true;
 	}
-	bool ConfigureCommand::run()
+	bool ConfigureCommand::run(mcp2200::Device &device)
 	{
-		mcp2200::Device device;
-		if (!m_target.open(device)){
+		mcp2200::Command response;
+		if (!device.readAll(response)){
 			return false;
 		}
-		mcp2200::Command response;
-		if (device.readAll(response)){
-			if (m_print){
-				cout << response;
-			}else{
-				mcp2200::Command command(response);
-				command.setCommand(mcp2200::CommandType::configure);
-				if (m_rx_led_set)
-					command.setRxLedMode(m_rx_led);
-				if (m_tx_led_set)
-					command.setTxLedMode(m_tx_led);
-				if (m_suspend_set)
-					command.setSuspend(m_suspend);
-				if (m_configuration_set)
-					command.setUsbConfigure(m_configuration);
-				if (m_invert_set)
-					command.setInvert(m_invert);
-				if (m_flow_control_set)
-					command.setFlowControl(m_flow_control);
-				if (m_direction_set)
-					command.setIoDirections(m_direction);
-				if (m_default_set)
-					command.setDefaultValues(m_default);
-				if (m_blink_speed_set)
-					command.setBlinkSpeed(!m_blink_speed);
-				if (!device.write(command)){
-					cerr << "could not write configuration\n";
-					device.close();
-					return false;
-				}
+		if (m_print){
+			cout << response;
+		}else{
+			mcp2200::Command command(response);
+			command.setCommand(mcp2200::CommandType::configure);
+			if (m_rx_led_set)
+				command.setRxLedMode(m_rx_led);
+			if (m_tx_led_set)
+				command.setTxLedMode(m_tx_led);
+			if (m_suspend_set)
+				command.setSuspend(m_suspend);
+			if (m_configuration_set)
+				command.setUsbConfigure(m_configuration);
+			if (m_invert_set)
+				command.setInvert(m_invert);
+			if (m_flow_control_set)
+				command.setFlowControl(m_flow_control);
+			if (m_direction_set)
+				command.setIoDirections(m_direction);
+			if (m_default_set)
+				command.setDefaultValues(m_default);
+			if (m_blink_speed_set)
+				command.setBlinkSpeed(!m_blink_speed);
+			if (!device.write(command)){
+				cerr << "could not write configuration\n";
+				return false;
 			}
 		}
-		device.close();
 		return true;
 	}
 }
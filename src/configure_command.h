@@ -24,22 +24,21 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #ifndef HEADER_CONFIGURE_COMMAND_H_
 #define HEADER_CONFIGURE_COMMAND_H_
-#include "command.h"
-#include "target.h"
+#include "device_command.h"
 #include "helpers.h"
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/variables_map.hpp>
 namespace command_line
 {
-	struct ConfigureCommand: public Command
+	struct ConfigureCommand: public DeviceCommand
 	{
 		ConfigureCommand();
 		virtual ~ConfigureCommand();
 		virtual void addOptions(boost::program_options::options_description &options, boost::program_options::options_description &hidden_options);
 		virtual bool checkOptions(boost::program_options::variables_map &variable_map);
-		virtual bool run();
+		using DeviceCommand::run;
+		virtual bool run(mcp2200::Device &device);
 		private:
-		Target m_target;
 		BitMap<uint8_t> m_direction, m_default;
 		mcp2200::LedMode m_rx_led, m_tx_led;
 		bool m_invert, m_suspend, m_configuration, m_flow_control, m_blink_speed;
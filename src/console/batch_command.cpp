@@ -0,0 +1,108 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "batch_command.h"
+#include "interpreter.h"
+#include "helpers.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <chrono>
+using namespace std;
+namespace po = boost::program_options;
+namespace command_line
+{
+	static double toMilliseconds(const Interpreter::Duration &duration)
+	{
+		return chrono::duration<double, milli>(duration).count();
+	}
+	BatchCommand::BatchCommand(Program *program):
+		Command("batch", "run commands from a script on one open device", "[FILE]"),
+		m_program(program),
+		m_keep_going(false)
+	{
+	}
+	BatchCommand::~BatchCommand()
+	{
+	}
+	bool BatchCommand::runsInterpreter() const
+	{
+		return true;
+	}
+	void BatchCommand::addOptions(po::options_description &options, po::options_description &hidden_options)
+	{
+		m_target.addOptions(options, hidden_options);
+		options.add_options()
+			("keep-going,k", po::value<bool>(&m_keep_going)->default_value(false)->zero_tokens(), "continue after a failed line")
+		;
+		hidden_options.add_options()
+			("file", po::value<string>(&m_file)->default_value("-"), "")
+		;
+	}
+	void BatchCommand::addPositionalOptions(po::positional_options_description &positional_options)
+	{
+		positional_options.add("file", 1);
+	}
+	bool BatchCommand::checkOptions(po::variables_map &variable_map)
+	{
+		return m_target.checkOptions(variable_map);
+	}
+	bool BatchCommand::run()
+	{
+		ifstream file;
+		istream *input = &cin;
+		if (m_file != "-"){
+			file.open(m_file);
+			if (!file.is_open()){
+				cerr << "could not open script (" << m_file << ")\n";
+				return false;
+			}
+			input = &file;
+		}
+		Interpreter interpreter(*m_program, *this, m_target);
+		ostream_state_saver state(cerr);
+		cerr << fixed << setprecision(3);
+		string line;
+		size_t line_number = 0, executed = 0, failed = 0;
+		Interpreter::Duration total = Interpreter::Duration::zero();
+		while (getline(*input, line)){
+			line_number++;
+			auto first = line.find_first_not_of(" \t\r");
+			if (first == string::npos || line[first] == '#') continue;
+			auto start = chrono::steady_clock::now();
+			bool result = interpreter.execute(line);
+			auto duration = chrono::steady_clock::now() - start;
+			cout.flush();
+			total += duration;
+			executed++;
+			cerr << "line " << line_number << ": " << toMilliseconds(duration) << " ms" << (result ? "" : ", failed") << "\n";
+			if (!result){
+				failed++;
+				if (!m_keep_going) break;
+			}
+		}
+		cerr << "total: " << executed << " lines in " << toMilliseconds(total) << " ms, device open " << toMilliseconds(interpreter.getOpenDuration()) << " ms\n";
+		return failed == 0;
+	}
+}
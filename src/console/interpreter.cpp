@@ -0,0 +1,156 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "interpreter.h"
+#include "device_command.h"
+#include <iostream>
+#include <iomanip>
+#include <boost/program_options/parsers.hpp>
+namespace po = boost::program_options;
+using namespace std;
+namespace command_line
+{
+	Interpreter::Interpreter(Program &program, Command &owner, Target &target):
+		m_program(program),
+		m_owner(owner),
+		m_target(target),
+		m_open_duration(Duration::zero()),
+		m_reconnect_timeout(0),
+		m_udev_open(false)
+	{
+	}
+	mcp2200::Device &Interpreter::getDevice()
+	{
+		return m_session.getDevice();
+	}
+	bool Interpreter::openDevice()
+	{
+		if (m_session.isConnected()) return true;
+		auto start = chrono::steady_clock::now();
+		bool result;
+		if (m_reconnect_timeout > 0 && !m_session.getOutages().empty()){
+			result = m_session.reconnect(m_reconnect_timeout);
+			if (!result)
+				cerr << "device did not reconnect within " << m_reconnect_timeout << " ms\n";
+		}else{
+			result = m_target.open(m_session.getDevice()) && m_session.attach(m_target.getVendorId(), m_target.getProductId());
+		}
+		m_open_duration += chrono::steady_clock::now() - start;
+		return result;
+	}
+	void Interpreter::setReconnectTimeout(int timeout_ms)
+	{
+		m_reconnect_timeout = timeout_ms;
+		m_session.setReconnectTimeout(timeout_ms);
+#ifdef HAVE_LIBUDEV
+		// Removal events mark the session disconnected while the shell waits for input, so the next command reconnects before using a dead handle.
+		if (timeout_ms > 0 && !m_udev_open)
+			m_udev_open = m_udev.open();
+#endif
+	}
+	void Interpreter::readRemovals()
+	{
+#ifdef HAVE_LIBUDEV
+		if (!m_udev_open) return;
+		bool received;
+		do{
+			received = false;
+			if (!m_udev.read([this, &received](const mcp2200::UdevEvent &event){
+				received = true;
+				if (event.action == mcp2200::UdevEvent::Action::remove)
+					m_session.notifyRemoved(event.path);
+			}, 0)) break;
+		}while (received);
+#endif
+	}
+	const mcp2200::Session &Interpreter::getSession() const
+	{
+		return m_session;
+	}
+	const Interpreter::Duration &Interpreter::getOpenDuration() const
+	{
+		return m_open_duration;
+	}
+	bool Interpreter::execute(const string &line)
+	{
+		auto arguments = po::split_unix(line);
+		if (arguments.empty()) return true;
+		shared_ptr<Command> command;
+		switch (m_program.parseCommandLine(arguments, command, true)){
+			case Program::ParseResult::success:
+				return true;
+			case Program::ParseResult::failure:
+				return false;
+			case Program::ParseResult::run:
+				break;
+		}
+		try{
+			auto device_command = dynamic_pointer_cast<DeviceCommand>(command);
+			if (!device_command){
+				return command->run();
+			}
+			// All lines use the device opened by the owner command, a device selected on one line would otherwise be silently ignored.
+			if (device_command->getTarget().isSet()){
+				cerr << command->getName() << ": device selection options are not supported here, select the device with '" << m_owner.getName() << "' options\n";
+				return false;
+			}
+			if (m_reconnect_timeout > 0)
+				readRemovals();
+			if (!openDevice()){
+				return false;
+			}
+			bool result = device_command->run(getDevice());
+			if (m_reconnect_timeout > 0){
+				// Reading state back both records what has to be replayed and detects a lost device, which is then reconnected right away.
+				// Replayed state is the one read after the previous command, so a command which failed because the device was lost is run again.
+				size_t outages = m_session.getOutages().size();
+				bool connected = m_session.capture();
+				if (m_session.getOutages().size() > outages){
+					if (!connected){
+						cerr << "device did not reconnect within " << m_reconnect_timeout << " ms\n";
+						return false;
+					}
+					{
+						ostream_state_saver state(cerr);
+						cerr << "device reconnected after " << fixed << setprecision(3) << m_session.getOutages().back().downtime_us / 1000.0 << " ms\n";
+					}
+					if (result){
+						cerr << "device was lost after '" << command->getName() << "' completed, its changes may not be restored\n";
+					}else{
+						cerr << "running '" << command->getName() << "' again\n";
+						result = device_command->run(getDevice()) && m_session.capture();
+						if (!result)
+							cerr << "'" << command->getName() << "' failed after reconnect\n";
+					}
+				}else if (!connected){
+					cerr << "device did not reconnect within " << m_reconnect_timeout << " ms\n";
+				}
+			}
+			return result;
+		}catch(const exception &e){
+			cerr << command->getName() << ": " << e.what() << "\n";
+			return false;
+		}
+	}
+}
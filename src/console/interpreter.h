@@ -0,0 +1,63 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_INTERPRETER_H_
+#define HEADER_INTERPRETER_H_
+#include "mcp2200ctl.h"
+#include "command.h"
+#include "target.h"
+#include "mcp2200.h"
+#include "session.h"
+#ifdef HAVE_LIBUDEV
+#include "udev.h"
+#endif
+#include <string>
+#include <chrono>
+namespace command_line
+{
+	struct Interpreter
+	{
+		typedef std::chrono::steady_clock::duration Duration;
+		Interpreter(Program &program, Command &owner, Target &target);
+		bool execute(const std::string &line);
+		mcp2200::Device &getDevice();
+		bool openDevice();
+		const Duration &getOpenDuration() const;
+		void setReconnectTimeout(int timeout_ms);
+		const mcp2200::Session &getSession() const;
+		private:
+		Program &m_program;
+		Command &m_owner;
+		Target &m_target;
+		mcp2200::Session m_session;
+		Duration m_open_duration;
+		int m_reconnect_timeout;
+		bool m_udev_open;
+#ifdef HAVE_LIBUDEV
+		mcp2200::Udev m_udev;
+#endif
+		void readRemovals();
+	};
+}
+#endif /* HEADER_INTERPRETER_H_ */
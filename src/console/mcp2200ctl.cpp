@@ -32,6 +32,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "set_eeprom_command.h"
 #include "configure_command.h"
 #include "describe_command.h"
+#include "watch_command.h"
+#ifdef LINUX_BUILD
+#include "uart_command.h"
+#include "uart_bench_command.h"
+#include "uart_aggregate_command.h"
+#include "uart_frames_command.h"
+#include "capture_command.h"
+#endif
+#include "batch_command.h"
+#include "shell_command.h"
 #include "helpers.h"
 #include "version.h"
 #include <iostream>
@@ -81,8 +91,18 @@ namespace command_line
 		addCommand(make_shared<SetCommand>());
 		addCommand(make_shared<ConfigureCommand>());
 		addCommand(make_shared<DescribeCommand>());
+		addCommand(make_shared<WatchCommand>());
+#ifdef LINUX_BUILD
+		addCommand(make_shared<UartCommand>());
+		addCommand(make_shared<UartBenchCommand>());
+		addCommand(make_shared<UartAggregateCommand>());
+		addCommand(make_shared<UartFramesCommand>());
+		addCommand(make_shared<CaptureCommand>());
+#endif
 		addCommand(make_shared<GetEepromCommand>());
 		addCommand(make_shared<SetEepromCommand>());
+		addCommand(make_shared<BatchCommand>(this));
+		addCommand(make_shared<ShellCommand>(this));
 		addCommand(make_shared<HelpCommand>(this));
 	}
 	Program::~Program()
@@ -174,31 +194,25 @@ namespace command_line
 		setlocale(LC_CTYPE, "en_US.utf8");
 #endif
 	}
-	int Program::run(int argc, char **argv)
+	Program::ParseResult Program::parseCommandLine(const vector<string> &command_line, shared_ptr<Command> &command, bool nested)
 	{
-		setLocale();
-#ifdef WIN32
-		auto command_line = po::split_winmain(ucsToUtf8(wstring(GetCommandLine())));
-		command_line.erase(command_line.begin());
-#else
-		vector<string> command_line;
-		command_line.resize(argc - 1);
-		for (int i = 1; i < argc; i++) {
-			command_line[i - 1] = argv[i];
-		}
-#endif
 		auto command_name = getCommandName(command_line);
-		if (!command_name.first) return EXIT_FAILURE;
+		if (!command_name.first) return ParseResult::success;
 
 		if (command_name.first && command_name.second == ""){
 			printHelp();
-			return EXIT_FAILURE;
+			return ParseResult::failure;
 		}
-		auto command = findCommand(command_name.second.c_str());
+		command = findCommand(command_name.second.c_str());
 		if (!command){
 			cerr << program_name << ": " << "unknown command '" << command_name.second << "'" << "\n";
 			printHelp();
-			return EXIT_FAILURE;
+			return ParseResult::failure;
+		}
+		// Checked before parsing, options of a running interpreter command would otherwise be overwritten.
+		if (nested && command->runsInterpreter()){
+			cerr << "nested '" << command->getName() << "' command is not supported\n";
+			return ParseResult::failure;
 		}
 
 		try{
@@ -219,13 +233,42 @@ namespace command_line
 			po::notify(vm);
 			if (vm.count("help")) {
 				printHelp(*command);
-				return EXIT_SUCCESS;
+				return ParseResult::success;
 			}
 			if (!command->checkOptions(vm)){
 				printHelp(*command);
-				return EXIT_FAILURE;
+				return ParseResult::failure;
 			}
-			return command->run();
+			return ParseResult::run;
+		}catch(const exception &e){
+			cerr << program_name << ": " << e.what() << "\n";
+			return ParseResult::failure;
+		}
+	}
+	int Program::run(int argc, char **argv)
+	{
+		setLocale();
+#ifdef WIN32
+		auto command_line = po::split_winmain(ucsToUtf8(wstring(GetCommandLine())));
+		command_line.erase(command_line.begin());
+#else
+		vector<string> command_line;
+		command_line.resize(argc - 1);
+		for (int i = 1; i < argc; i++) {
+			command_line[i - 1] = argv[i];
+		}
+#endif
+		shared_ptr<Command> command;
+		switch (parseCommandLine(command_line, command)){
+			case ParseResult::success:
+				return EXIT_SUCCESS;
+			case ParseResult::failure:
+				return EXIT_FAILURE;
+			case ParseResult::run:
+				break;
+		}
+		try{
+			return command->run() ? EXIT_SUCCESS : EXIT_FAILURE;
 		}catch(const exception &e){
 			cerr << program_name << ": " << e.what() << "\n";
 			return EXIT_FAILURE;
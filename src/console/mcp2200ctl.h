@@ -32,9 +32,16 @@ namespace command_line
 {
 	struct Program
 	{
+		enum class ParseResult
+		{
+			run,
+			success,
+			failure,
+		};
 		Program();
 		~Program();
 		int run(int argc, char **argv);
+		ParseResult parseCommandLine(const std::vector<std::string> &command_line, std::shared_ptr<Command> &command, bool nested = false);
 		void printHelp();
 		private:
 		typedef std::pair<std::string, std::shared_ptr<Command>> CommandPair;
@@ -0,0 +1,197 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "shell_command.h"
+#include "interpreter.h"
+#include "helpers.h"
+#include "format.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#ifdef WIN32
+#include <io.h>
+#define isatty _isatty
+#define fileno _fileno
+#else
+#include <unistd.h>
+#endif
+using namespace std;
+namespace po = boost::program_options;
+namespace command_line
+{
+	const static char *shell_help =
+		"Enter commands without the program name, for example \"get\" or \"set 01000000\".\n"
+		"Shell commands:\n"
+		"  state         print cached device state\n"
+		"  refresh       read device state and print it\n"
+		"  history       print command history\n"
+		"  outages       print device disconnects and their downtime (see --reconnect)\n"
+		"  !!            repeat the last command\n"
+		"  !N            repeat command N from history\n"
+		"  quit, exit    leave the shell\n";
+	ShellCommand::ShellCommand(Program *program):
+		Command("shell", "interactive shell keeping the device open"),
+		m_program(program),
+		m_timing(false),
+		m_state_valid(false),
+		m_reconnect_timeout(0)
+	{
+	}
+	ShellCommand::~ShellCommand()
+	{
+	}
+	bool ShellCommand::runsInterpreter() const
+	{
+		return true;
+	}
+	void ShellCommand::addOptions(po::options_description &options, po::options_description &hidden_options)
+	{
+		m_target.addOptions(options, hidden_options);
+		options.add_options()
+			("timing,t", po::value<bool>(&m_timing)->default_value(false)->zero_tokens(), "print time taken by each command")
+			("reconnect", po::value<int>(&m_reconnect_timeout)->default_value(0), "when the device is lost, wait up to given number of milliseconds for it to come back and restore its configuration and outputs")
+		;
+	}
+	bool ShellCommand::checkOptions(po::variables_map &variable_map)
+	{
+		return m_target.checkOptions(variable_map);
+	}
+	bool ShellCommand::expandHistory(string &line)
+	{
+		if (line.size() < 2 || line[0] != '!') return true;
+		size_t index;
+		if (line == "!!"){
+			index = m_history.size();
+		}else{
+			try{
+				size_t end;
+				index = stoul(line.substr(1), &end);
+				if (end != line.size() - 1) throw invalid_argument(line);
+			}catch(const exception &){
+				cerr << "invalid history reference '" << line << "'\n";
+				return false;
+			}
+		}
+		if (index < 1 || index > m_history.size()){
+			cerr << "no such history entry '" << line << "'\n";
+			return false;
+		}
+		line = m_history[index - 1];
+		cout << line << "\n";
+		return true;
+	}
+	void ShellCommand::printHistory()
+	{
+		ostream_state_saver state(cout);
+		for (size_t i = 0; i < m_history.size(); i++){
+			cout << setw(5) << i + 1 << "  " << m_history[i] << "\n";
+		}
+	}
+	bool ShellCommand::printState(Interpreter &interpreter, bool refresh)
+	{
+		if (refresh || !m_state_valid){
+			if (!interpreter.openDevice()) return false;
+			m_state_valid = interpreter.getDevice().readAll(m_state);
+			if (!m_state_valid){
+				cerr << "could not read device state\n";
+				return false;
+			}
+		}
+		cout << m_state;
+		return true;
+	}
+	void ShellCommand::printOutages(Interpreter &interpreter)
+	{
+		ostream_state_saver state(cout);
+		auto &outages = interpreter.getSession().getOutages();
+		cout << fixed << setprecision(3);
+		for (size_t i = 0; i < outages.size(); i++){
+			cout << setw(5) << i + 1 << "  " << outages[i].reason << ", ";
+			if (outages[i].downtime_us < 0)
+				cout << "not recovered\n";
+			else
+				cout << "down " << outages[i].downtime_us / 1000.0 << " ms\n";
+		}
+	}
+	bool ShellCommand::runBuiltin(Interpreter &interpreter, const string &line, bool &exit)
+	{
+		if (line == "quit" || line == "exit"){
+			exit = true;
+		}else if (line == "history"){
+			printHistory();
+		}else if (line == "state"){
+			printState(interpreter, false);
+		}else if (line == "refresh"){
+			printState(interpreter, true);
+		}else if (line == "outages"){
+			printOutages(interpreter);
+		}else if (line == "?"){
+			cout << shell_help;
+		}else{
+			return false;
+		}
+		return true;
+	}
+	bool ShellCommand::run()
+	{
+		bool interactive = isatty(fileno(stdin));
+		Interpreter interpreter(*m_program, *this, m_target);
+		interpreter.setReconnectTimeout(m_reconnect_timeout);
+		if (interactive){
+			cout << "Type \"?\" for shell commands, \"help\" for program commands.\n";
+			if (!interpreter.openDevice()){
+				cerr << "device will be opened when a device command is entered\n";
+			}
+		}
+		m_state_valid = false;
+		string line;
+		bool exit = false;
+		while (!exit){
+			if (interactive){
+				cout << "mcp2200> " << flush;
+			}
+			if (!getline(cin, line)) break;
+			auto first = line.find_first_not_of(" \t\r");
+			if (first == string::npos || line[first] == '#') continue;
+			line = line.substr(first, line.find_last_not_of(" \t\r") - first + 1);
+			if (!expandHistory(line)) continue;
+			m_history.push_back(line);
+			auto start = chrono::steady_clock::now();
+			if (!runBuiltin(interpreter, line, exit)){
+				interpreter.execute(line);
+				m_state_valid = false;
+			}
+			if (m_timing){
+				ostream_state_saver state(cerr);
+				cerr << fixed << setprecision(3) << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() << " ms\n";
+			}
+			cout.flush();
+		}
+		if (interactive && !exit){
+			cout << "\n";
+		}
+		return true;
+	}
+}
@@ -0,0 +1,60 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_SHELL_COMMAND_H_
+#define HEADER_SHELL_COMMAND_H_
+#include "command.h"
+#include "target.h"
+#include "mcp2200.h"
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/variables_map.hpp>
+#include <string>
+#include <vector>
+namespace command_line
+{
+	struct Program;
+	struct Interpreter;
+	struct ShellCommand: public Command
+	{
+		ShellCommand(Program *program);
+		virtual ~ShellCommand();
+		virtual void addOptions(boost::program_options::options_description &options, boost::program_options::options_description &hidden_options);
+		virtual bool checkOptions(boost::program_options::variables_map &variable_map);
+		virtual bool run();
+		virtual bool runsInterpreter() const;
+		private:
+		Program *m_program;
+		Target m_target;
+		bool m_timing, m_state_valid;
+		int m_reconnect_timeout;
+		mcp2200::Command m_state;
+		std::vector<std::string> m_history;
+		bool expandHistory(std::string &line);
+		bool runBuiltin(Interpreter &interpreter, const std::string &line, bool &exit);
+		void printHistory();
+		bool printState(Interpreter &interpreter, bool refresh);
+		void printOutages(Interpreter &interpreter);
+	};
+}
+#endif /* HEADER_SHELL_COMMAND_H_ */
@@ -24,13 +24,16 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "describe_command.h"
 #include "mcp2200.h"
+#include "reenumeration.h"
 #include <iostream>
+#include <iomanip>
 using namespace std;
 namespace po = boost::program_options;
 namespace command_line
 {
 	DescribeCommand::DescribeCommand():
-		Command("describe", "get or set device description")
+		DeviceCommand("describe", "get or set device description"),
+		m_reconnect_timeout(0)
 	{
 	}
 	DescribeCommand::~DescribeCommand()
@@ -38,17 +41,18 @@ namespace command_line
 	}
 	void DescribeCommand::addOptions(po::options_description &options, po::options_description &hidden_options)
 	{
-		m_target.addOptions(options, hidden_options);
+		DeviceCommand::addOptions(options, hidden_options);
 		options.add_options()
 			("set-manufacturer,m", po::value<string>(&m_manufacturer), "set manufacturer string")
 			("set-product,p", po::value<string>(&m_product), "set product string")
 			("set-vendor-id", po::value<HexOption<uint16_t>>(&m_vendor_id), "set vendor ID")
 			("set-product-id", po::value<HexOption<uint16_t>>(&m_product_id), "set product ID")
+			("reconnect", po::value<int>(&m_reconnect_timeout)->default_value(0), "after setting vendor or product ID, wait up to given number of milliseconds for the device to reappear with new IDs and print reconnect time")
 		;
 	}
 	bool DescribeCommand::checkOptions(po::variables_map &variable_map)
 	{
-		if (!m_target.checkOptions(variable_map)) return false;
+		if (!DeviceCommand::checkOptions(variable_map)) return false;
 		m_manufacturer_set = variable_map.count("set-manufacturer") > 0;
 		m_product_set = variable_map.count("set-product") > 0;
 		m_vendor_id_set = variable_map.count("set-vendor-id") > 0;
@@ -56,12 +60,8 @@ namespace command_line
 		m_print = !(m_manufacturer_set || m_product_set || m_vendor_id_set || m_product_id_set);
 		return true;
 	}
-	bool DescribeCommand::run()
+	bool DescribeCommand::run(mcp2200::Device &device)
 	{
-		mcp2200::Device device;
-		if (!m_target.open(device)){
-			return false;
-		}
 		if (!m_print){
 			if (m_manufacturer_set)
 				device.setManufacturer(m_manufacturer.c_str());
@@ -70,7 +70,25 @@ namespace command_line
 			if (m_vendor_id_set || m_product_id_set){
 				auto vendor_id = m_vendor_id_set ? static_cast<uint16_t>(m_vendor_id) : m_target.getVendorId();
 				auto product_id = m_product_id_set ? static_cast<uint16_t>(m_product_id) : m_target.getProductId();
-				device.setVendorProductIds(vendor_id, product_id);
+				if (m_reconnect_timeout <= 0){
+					device.setVendorProductIds(vendor_id, product_id);
+					return true;
+				}
+				string serial;
+				device.getSerial(serial);
+				mcp2200::Reenumeration reenumeration;
+				reenumeration.start(serial, vendor_id, product_id);
+				if (!device.setVendorProductIds(vendor_id, product_id)){
+					cerr << "could not set vendor and product IDs\n";
+					return false;
+				}
+				device.close();
+				if (!reenumeration.wait(device, m_reconnect_timeout)){
+					cerr << "device did not reappear within " << m_reconnect_timeout << " ms\n";
+					return false;
+				}
+				ostream_state_saver state(cout);
+				cout << "Reconnected in " << fixed << setprecision(3) << reenumeration.getLatency() / 1000.0 << " ms (" << reenumeration.getPath() << ")\n";
 			}
 		}else{
 			string manufacturer, product, serial;
@@ -82,7 +100,6 @@ namespace command_line
 				<< "Product: " << product << "\n"
 				<< "Serial: " << serial << "\n";
 		}
-		device.close();
 		return true;
 	}
 }
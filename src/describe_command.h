@@ -24,24 +24,24 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #ifndef HEADER_DESCRIBE_COMMAND_H_
 #define HEADER_DESCRIBE_COMMAND_H_
-#include "command.h"
-#include "target.h"
+#include "device_command.h"
 #include "helpers.h"
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/variables_map.hpp>
 namespace command_line
 {
-	struct DescribeCommand: public Command
+	struct DescribeCommand: public DeviceCommand
 	{
 		DescribeCommand();
 		virtual ~DescribeCommand();
 		virtual void addOptions(boost::program_options::options_description &options, boost::program_options::options_description &hidden_options);
 		virtual bool checkOptions(boost::program_options::variables_map &variable_map);
-		virtual bool run();
+		using DeviceCommand::run;
+		virtual bool run(mcp2200::Device &device);
 		private:
-		Target m_target;
 		std::string m_manufacturer, m_product;
 		HexOption<uint16_t> m_vendor_id, m_product_id;
+		int m_reconnect_timeout;
 		bool m_manufacturer_set, m_product_set, m_vendor_id_set, m_product_id_set, m_print;
 	};
 }
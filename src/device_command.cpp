@@ -0,0 +1,62 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "device_command.h"
+namespace po = boost::program_options;
+namespace command_line
+{
+	DeviceCommand::DeviceCommand(const char *name, const char *description):
+		Command(name, description)
+	{
+	}
+	DeviceCommand::DeviceCommand(const char *name, const char *description, const char *command_pattern):
+		Command(name, description, command_pattern)
+	{
+	}
+	DeviceCommand::~DeviceCommand()
+	{
+	}
+	void DeviceCommand::addOptions(po::options_description &options, po::options_description &hidden_options)
+	{
+		m_target.addOptions(options, hidden_options);
+	}
+	bool DeviceCommand::checkOptions(po::variables_map &variable_map)
+	{
+		return m_target.checkOptions(variable_map);
+	}
+	bool DeviceCommand::run()
+	{
+		mcp2200::Device device;
+		if (!m_target.open(device)){
+			return false;
+		}
+		bool result = run(device);
+		device.close();
+		return result;
+	}
+	const Target &DeviceCommand::getTarget() const
+	{
+		return m_target;
+	}
+}
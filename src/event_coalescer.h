@@ -0,0 +1,116 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_EVENT_COALESCER_H_
+#define HEADER_EVENT_COALESCER_H_
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <mutex>
+#include <utility>
+#include <optional>
+namespace mcp2200
+{
+	struct CoalescerStatistics
+	{
+		uint64_t events, batches, merged;
+		CoalescerStatistics():
+			events(0),
+			batches(0),
+			merged(0)
+		{
+		}
+		uint64_t getSavedRefreshes() const
+		{
+			return events - batches;
+		}
+	};
+	// Collects events pushed from one thread and hands them over to another thread in batches. The first and the last event for each
+	// key are kept, so a removal followed by an addition of the same key is delivered as both events and the consumer can release
+	// whatever it held for the old instance.
+	template <typename Key, typename Event>
+	struct EventCoalescer
+	{
+		EventCoalescer():
+			m_pending(false)
+		{
+		}
+		// Returns true when the event starts a new batch, caller should then schedule a call to take.
+		bool push(const Key &key, const Event &event)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_statistics.events++;
+			bool started = !m_pending;
+			m_pending = true;
+			for (auto &item: m_events){
+				if (item.key == key){
+					if (item.last)
+						m_statistics.merged++;
+					item.last = event;
+					return started;
+				}
+			}
+			m_events.push_back(Item{key, event, std::nullopt});
+			return started;
+		}
+		std::vector<Event> take()
+		{
+			std::vector<Item> events;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				events.swap(m_events);
+				if (m_pending)
+					m_statistics.batches++;
+				m_pending = false;
+			}
+			std::vector<Event> result;
+			result.reserve(events.size() * 2);
+			for (auto &item: events){
+				result.push_back(std::move(item.first));
+				if (item.last)
+					result.push_back(std::move(*item.last));
+			}
+			return result;
+		}
+		CoalescerStatistics getStatistics()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_statistics;
+		}
+		private:
+		struct Item
+		{
+			Key key;
+			Event first;
+			std::optional<Event> last;
+		};
+		std::mutex m_mutex;
+		std::vector<Item> m_events;
+		CoalescerStatistics m_statistics;
+		bool m_pending;
+		EventCoalescer(EventCoalescer const &) = delete;
+		void operator=(EventCoalescer const &x) = delete;
+	};
+}
+#endif /* HEADER_EVENT_COALESCER_H_ */
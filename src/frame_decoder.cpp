@@ -0,0 +1,194 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "frame_decoder.h"
+#include <cstring>
+#include <algorithm>
+using namespace std;
+namespace mcp2200
+{
+	FrameDecoder::~FrameDecoder()
+	{
+	}
+	chrono::microseconds FrameDecoder::getGap() const
+	{
+		return chrono::microseconds(0);
+	}
+	bool FrameDecoder::isValid(const RingBuffer::Segments &) const
+	{
+		return true;
+	}
+	LineDecoder::LineDecoder(size_t max_length):
+		m_max_length(max_length)
+	{
+	}
+	size_t LineDecoder::decode(const RingBuffer::Segments &data, RingBuffer::Segments &frame, bool &)
+	{
+		size_t end;
+		auto found = static_cast<const uint8_t *>(memchr(data.first, '\n', data.first_size));
+		if (found){
+			end = found - data.first;
+		}else if ((found = static_cast<const uint8_t *>(memchr(data.second, '\n', data.second_size)))){
+			end = data.first_size + (found - data.second);
+		}else{
+			if (data.size() < m_max_length) return 0;
+			frame = data.slice(0, m_max_length);
+			return m_max_length;
+		}
+		size_t length = end;
+		if (length > 0 && data[length - 1] == '\r')
+			length--;
+		frame = data.slice(0, length);
+		return end + 1;
+	}
+	size_t LineDecoder::getMaxFrameSize() const
+	{
+		return m_max_length + 2;
+	}
+	LengthPrefixedDecoder::LengthPrefixedDecoder(size_t prefix_size, bool big_endian, size_t max_length):
+		m_prefix_size(prefix_size),
+		m_max_length(max_length),
+		m_big_endian(big_endian)
+	{
+	}
+	size_t LengthPrefixedDecoder::decode(const RingBuffer::Segments &data, RingBuffer::Segments &frame, bool &discard)
+	{
+		if (data.size() < m_prefix_size) return 0;
+		size_t length = 0;
+		for (size_t i = 0; i < m_prefix_size; i++){
+			size_t index = m_big_endian ? i : m_prefix_size - 1 - i;
+			length = (length << 8) | data[index];
+		}
+		if (length > m_max_length){
+			// Skip one byte at a time until a plausible length is found again.
+			discard = true;
+			return 1;
+		}
+		if (data.size() < m_prefix_size + length) return 0;
+		frame = data.slice(m_prefix_size, length);
+		return m_prefix_size + length;
+	}
+	size_t LengthPrefixedDecoder::getMaxFrameSize() const
+	{
+		return m_prefix_size + m_max_length;
+	}
+	ModbusRtuDecoder::ModbusRtuDecoder(int baud_rate, size_t max_length):
+		m_gap(getGap(baud_rate)),
+		m_max_length(max_length)
+	{
+	}
+	size_t ModbusRtuDecoder::decode(const RingBuffer::Segments &data, RingBuffer::Segments &frame, bool &)
+	{
+		// Frames are normally ended by line silence, data exceeding the maximum frame size can not be a single frame.
+		if (data.size() < m_max_length) return 0;
+		frame = data.slice(0, m_max_length);
+		return m_max_length;
+	}
+	size_t ModbusRtuDecoder::getMaxFrameSize() const
+	{
+		return m_max_length;
+	}
+	chrono::microseconds ModbusRtuDecoder::getGap() const
+	{
+		return m_gap;
+	}
+	chrono::microseconds ModbusRtuDecoder::getGap(int baud_rate)
+	{
+		// 3.5 characters of 11 bits each, fixed 1.75 ms above 19200 baud as recommended by the Modbus serial line specification.
+		if (baud_rate <= 0 || baud_rate > 19200)
+			return chrono::microseconds(1750);
+		return chrono::microseconds((385 * 100000 + baud_rate - 1) / baud_rate);
+	}
+	struct CrcTable
+	{
+		uint16_t values[256];
+		CrcTable()
+		{
+			for (int i = 0; i < 256; i++){
+				uint16_t crc = i;
+				for (int bit = 0; bit < 8; bit++)
+					crc = (crc & 1) ? (crc >> 1) ^ 0xa001 : crc >> 1;
+				values[i] = crc;
+			}
+		}
+	};
+	uint16_t ModbusRtuDecoder::crc(const RingBuffer::Segments &data)
+	{
+		const static CrcTable table;
+		uint16_t crc = 0xffff;
+		auto update = [&crc](const uint8_t *bytes, size_t size){
+			for (size_t i = 0; i < size; i++)
+				crc = (crc >> 8) ^ table.values[(crc ^ bytes[i]) & 0xff];
+		};
+		update(data.first, data.first_size);
+		update(data.second, data.second_size);
+		return crc;
+	}
+	bool ModbusRtuDecoder::isValid(const RingBuffer::Segments &frame) const
+	{
+		if (frame.size() < 4) return false;
+		size_t size = frame.size() - 2;
+		uint16_t expected = frame[size] | (frame[size + 1] << 8);
+		return crc(frame.slice(0, size)) == expected;
+	}
+	FrameStage::FrameStage(unique_ptr<FrameDecoder> decoder, size_t capacity):
+		m_decoder(move(decoder)),
+		m_ring(capacity > 0 ? capacity : max<size_t>(64 * 1024, 2 * m_decoder->getMaxFrameSize())),
+		m_gap_us(m_decoder->getGap().count()),
+		m_frame_time(0),
+		m_last_time(0),
+		m_frames(0),
+		m_invalid_frames(0),
+		m_discarded_bytes(0)
+	{
+	}
+	FrameDecoder &FrameStage::getDecoder()
+	{
+		return *m_decoder;
+	}
+	void FrameStage::received(bool was_empty, uint64_t time_us)
+	{
+		if (was_empty)
+			m_frame_time = time_us;
+		m_last_time = time_us;
+	}
+	int64_t FrameStage::getTimeout(uint64_t time_us) const
+	{
+		if (m_gap_us == 0 || m_ring.empty()) return -1;
+		uint64_t deadline = m_last_time + m_gap_us;
+		return deadline > time_us ? static_cast<int64_t>(deadline - time_us) : 0;
+	}
+	uint64_t FrameStage::getFrames() const
+	{
+		return m_frames;
+	}
+	uint64_t FrameStage::getInvalidFrames() const
+	{
+		return m_invalid_frames;
+	}
+	uint64_t FrameStage::getDiscardedBytes() const
+	{
+		return m_discarded_bytes;
+	}
+}
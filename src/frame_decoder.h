@@ -0,0 +1,180 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_FRAME_DECODER_H_
+#define HEADER_FRAME_DECODER_H_
+#include "ring_buffer.h"
+#include <stdint.h>
+#include <cstddef>
+#include <chrono>
+#include <memory>
+namespace mcp2200
+{
+	struct FrameDecoder
+	{
+		virtual ~FrameDecoder();
+		// Returns the number of bytes used by the frame found at the start of data, or zero when more data is needed. Frame is set to a view of the frame payload, which may be empty.
+		// Bytes which do not belong to any frame are skipped by returning their count with discard set.
+		virtual size_t decode(const RingBuffer::Segments &data, RingBuffer::Segments &frame, bool &discard) = 0;
+		// Line silence which ends a frame, zero when framing does not depend on timing.
+		virtual std::chrono::microseconds getGap() const;
+		virtual bool isValid(const RingBuffer::Segments &frame) const;
+		// Largest number of bytes a single frame occupies in the input, including framing bytes.
+		virtual size_t getMaxFrameSize() const = 0;
+	};
+	struct LineDecoder: public FrameDecoder
+	{
+		LineDecoder(size_t max_length = 4096);
+		virtual size_t decode(const RingBuffer::Segments &data, RingBuffer::Segments &frame, bool &discard);
+		virtual size_t getMaxFrameSize() const;
+		private:
+		size_t m_max_length;
+	};
+	struct LengthPrefixedDecoder: public FrameDecoder
+	{
+		LengthPrefixedDecoder(size_t prefix_size = 2, bool big_endian = true, size_t max_length = 65535);
+		virtual size_t decode(const RingBuffer::Segments &data, RingBuffer::Segments &frame, bool &discard);
+		virtual size_t getMaxFrameSize() const;
+		private:
+		size_t m_prefix_size, m_max_length;
+		bool m_big_endian;
+	};
+	struct ModbusRtuDecoder: public FrameDecoder
+	{
+		const static size_t max_adu_length = 256;
+		ModbusRtuDecoder(int baud_rate, size_t max_length = max_adu_length);
+		virtual size_t decode(const RingBuffer::Segments &data, RingBuffer::Segments &frame, bool &discard);
+		virtual std::chrono::microseconds getGap() const;
+		virtual bool isValid(const RingBuffer::Segments &frame) const;
+		virtual size_t getMaxFrameSize() const;
+		static std::chrono::microseconds getGap(int baud_rate);
+		static uint16_t crc(const RingBuffer::Segments &data);
+		private:
+		std::chrono::microseconds m_gap;
+		size_t m_max_length;
+	};
+	struct Frame
+	{
+		RingBuffer::Segments data;
+		uint64_t time_us;
+		bool valid;
+	};
+	struct FrameStage
+	{
+		// Zero capacity fits two frames of the maximum size, but not less than 64 KiB.
+		FrameStage(std::unique_ptr<FrameDecoder> decoder, size_t capacity = 0);
+		FrameDecoder &getDecoder();
+		template <typename Callback>
+		size_t write(const uint8_t *data, size_t size, uint64_t time_us, Callback &&callback);
+#ifdef LINUX_BUILD
+		template <typename Callback>
+		ssize_t receive(int fd, uint64_t time_us, Callback &&callback);
+#endif
+		template <typename Callback>
+		bool expire(uint64_t time_us, Callback &&callback);
+		int64_t getTimeout(uint64_t time_us) const;
+		uint64_t getFrames() const;
+		uint64_t getInvalidFrames() const;
+		uint64_t getDiscardedBytes() const;
+		private:
+		std::unique_ptr<FrameDecoder> m_decoder;
+		RingBuffer m_ring;
+		uint64_t m_gap_us, m_frame_time, m_last_time, m_frames, m_invalid_frames, m_discarded_bytes;
+		void received(bool was_empty, uint64_t time_us);
+		template <typename Callback>
+		void emit(const RingBuffer::Segments &frame, Callback &&callback);
+		template <typename Callback>
+		void decode(Callback &&callback);
+		FrameStage(FrameStage const &) = delete;
+		void operator=(FrameStage const &x) = delete;
+	};
+	template <typename Callback>
+	void FrameStage::emit(const RingBuffer::Segments &frame, Callback &&callback)
+	{
+		bool valid = m_decoder->isValid(frame);
+		m_frames++;
+		if (!valid) m_invalid_frames++;
+		callback(Frame{frame, m_frame_time, valid});
+	}
+	template <typename Callback>
+	void FrameStage::decode(Callback &&callback)
+	{
+		// Frames are handed out as views into the ring buffer and are consumed after the callback returns.
+		while (!m_ring.empty()){
+			RingBuffer::Segments frame = {};
+			bool discard = false;
+			size_t used = m_decoder->decode(m_ring.peek(), frame, discard);
+			if (used == 0){
+				if (m_ring.space() == 0){
+					m_discarded_bytes += m_ring.size();
+					m_ring.clear();
+				}
+				return;
+			}
+			if (discard)
+				m_discarded_bytes += used;
+			else
+				emit(frame, callback);
+			m_ring.consume(used);
+			m_frame_time = m_last_time;
+		}
+	}
+	template <typename Callback>
+	size_t FrameStage::write(const uint8_t *data, size_t size, uint64_t time_us, Callback &&callback)
+	{
+		expire(time_us, callback);
+		size_t written = 0;
+		while (written < size){
+			bool was_empty = m_ring.empty();
+			size_t count = m_ring.write(data + written, size - written);
+			written += count;
+			received(was_empty, time_us);
+			decode(callback);
+		}
+		return written;
+	}
+#ifdef LINUX_BUILD
+	template <typename Callback>
+	ssize_t FrameStage::receive(int fd, uint64_t time_us, Callback &&callback)
+	{
+		expire(time_us, callback);
+		bool was_empty = m_ring.empty();
+		ssize_t count = m_ring.readFrom(fd);
+		if (count <= 0) return count;
+		received(was_empty, time_us);
+		decode(callback);
+		return count;
+	}
+#endif
+	template <typename Callback>
+	bool FrameStage::expire(uint64_t time_us, Callback &&callback)
+	{
+		if (m_gap_us == 0 || m_ring.empty() || time_us - m_last_time < m_gap_us) return false;
+		auto frame = m_ring.peek();
+		emit(frame, callback);
+		m_ring.clear();
+		return true;
+	}
+}
+#endif /* HEADER_FRAME_DECODER_H_ */
@@ -32,7 +32,7 @@ namespace po = boost::program_options;
 namespace command_line
 {
 	GetCommand::GetCommand():
-		Command("get", "get GPIO state")
+		DeviceCommand("get", "get GPIO state")
 	{
 	}
 	GetCommand::~GetCommand()
@@ -40,23 +40,19 @@ namespace command_line
 	}
 	void GetCommand::addOptions(po::options_description &options, po::options_description &hidden_options)
 	{
-		m_target.addOptions(options, hidden_options);
+		DeviceCommand::addOptions(options, hidden_options);
 	}
 	bool GetCommand::checkOptions(po::variables_map &variable_map)
 	{
-		return m_target.checkOptions(variable_map);
+		return DeviceCommand::checkOptions(variable_map);
 	}
-	bool GetCommand::run()
+	bool GetCommand::run(mcp2200::Device &device)
 	{
-		mcp2200::Device device;
-		if (!m_target.open(device)){
-			return false;
-		}
 		mcp2200::Command response;
-		if (device.readAll(response)){
-			cout << "GPIO values: " << BitMap<uint8_t>(response.getGpioValues()) << "\n";
+		if (!device.readAll(response)){
+			return false;
 		}
-		device.close();
+		cout << "GPIO values: " << BitMap<uint8_t>(response.getGpioValues()) << "\n";
 		return true;
 	}
 }
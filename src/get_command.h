@@ -24,21 +24,19 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #ifndef HEADER_GET_COMMAND_H_
 #define HEADER_GET_COMMAND_H_
-#include "command.h"
-#include "target.h"
+#include "device_command.h"
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/variables_map.hpp>
 namespace command_line
 {
-	struct GetCommand: public Command
+	struct GetCommand: public DeviceCommand
 	{
 		GetCommand();
 		virtual ~GetCommand();
 		virtual void addOptions(boost::program_options::options_description &options, boost::program_options::options_description &hidden_options);
 		virtual bool checkOptions(boost::program_options::variables_map &variable_map);
-		virtual bool run();
-		private:
-		Target m_target;
+		using DeviceCommand::run;
+		virtual bool run(mcp2200::Device &device);
 	};
 }
 #endif /* HEADER_GET_COMMAND_H_ */
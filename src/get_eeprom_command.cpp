@@ -32,7 +32,7 @@ namespace po = boost::program_options;
 namespace command_line
 {
 	GetEepromCommand::GetEepromCommand():
-		Command("get-eeprom", "get EEPROM value")
+		DeviceCommand("get-eeprom", "get EEPROM value")
 	{
 	}
 	GetEepromCommand::~GetEepromCommand()
@@ -41,27 +41,23 @@ namespace command_line
 	void GetEepromCommand::addOptions(po::options_description &options, po::options_description &hidden_options)
 	{
 		using namespace boost::program_options;
-		m_target.addOptions(options, hidden_options);
+		DeviceCommand::addOptions(options, hidden_options);
 		options.add_options()
 			("address,a",  po::value<int>(&m_address)->notifier([](int value){ if (value < 0 || value > 255) throw validation_error(validation_error::invalid_option_value, "address", to_string(value)); }), "EEPROM address [0; 255]")
 		;
 	}
 	bool GetEepromCommand::checkOptions(po::variables_map &variable_map)
 	{
-		return m_target.checkOptions(variable_map);
+		return DeviceCommand::checkOptions(variable_map);
 	}
-	bool GetEepromCommand::run()
+	bool GetEepromCommand::run(mcp2200::Device &device)
 	{
-		mcp2200::Device device;
-		if (!m_target.open(device)){
-			return false;
-		}
 		uint8_t value;
-		if (device.readEeprom(m_address, value)){
-			ostream_state_saver state(cout);
-			cout << "EEPROM value: " << setfill('0') << hex << setw(2) << static_cast<int>(value) << "\n";
+		if (!device.readEeprom(m_address, value)){
+			return false;
 		}
-		device.close();
+		ostream_state_saver state(cout);
+		cout << "EEPROM value: " << setfill('0') << hex << setw(2) << static_cast<int>(value) << "\n";
 		return true;
 	}
 }
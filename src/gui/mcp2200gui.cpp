@@ -25,13 +25,25 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "mcp2200gui.h"
 #include "enum.h"
 #include "mcp2200.h"
+#include "event_coalescer.h"
+#include "format.h"
+#include "helpers.h"
+#include "poll_scheduler.h"
+#include "reenumeration.h"
+#include "serial_index.h"
+#include "worker.h"
 #include "paths.h"
+#include "timeline_view.h"
 #include "types.h"
-#include "udev/udev.h"
+#include "udev.h"
 #include <gtk/gtk.h>
 #include <json/json.h>
 #include <hidapi/hidapi.h>
 #include <cstddef>
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <memory>
 #include <thread>
 #include <mutex>
 #include <iomanip>
@@ -49,11 +61,28 @@ namespace gui
 		manufacturer = 2,
 		product = 3,
 		release_number = 4,
+		status = 5,
+	};
+	enum class DashboardColumn: int
+	{
+		path = 0,
+		serial = 1,
+		product = 2,
+		gpio = 3,
+		directions = 4,
+		rx_led = 5,
+		tx_led = 6,
+		baud_rate = 7,
+		options = 8,
 	};
 	struct Program::Impl
 	{
 		Program *m_decl;
-		GtkWidget *m_window, *m_menu, *m_notebook, *m_device_list;
+		GtkWidget *m_window, *m_menu, *m_notebook, *m_device_list, *m_device_search;
+		GtkListStore *m_device_store;
+		GtkTreeModel *m_device_filter_model;
+		string m_device_filter;
+		unordered_map<string, GtkTreeIter> m_device_rows;
 		GtkWidget *m_invert, *m_flow_control, *m_usb_configure, *m_suspend, *m_fast_blink;
 		GtkWidget *m_tx[3], *m_rx[3];
 		struct Gpio
@@ -63,7 +92,43 @@ namespace gui
 		Gpio m_gpio[8];
 		GtkWidget *m_vid, *m_pid, *m_product, *m_manufacturer;
 		GtkWidget *m_new_vid, *m_new_pid, *m_new_product, *m_new_manufacturer;
-		GtkWidget *m_description_scrolled_widget, *m_device_scrolled_widget;
+		GtkWidget *m_device_list_box, *m_device_list_stack, *m_device_holder, *m_description_device_holder;
+		GtkWidget *m_description_page, *m_configuration_page;
+		bool m_description_page_built, m_configuration_page_built, m_device_description_valid;
+		string m_device_manufacturer, m_device_product;
+		gint64 m_start_time, m_devices_listed_time;
+		gulong m_first_draw_handler;
+		GtkWidget *m_spinner, *m_status;
+		mcp2200::Worker m_worker, m_apply_workers;
+		int m_operations;
+		struct OpenDevice
+		{
+			mcp2200::Device device;
+			string path, manufacturer, product;
+			mcp2200::Command state;
+			bool state_valid, description_valid;
+			OpenDevice():
+				state_valid(false),
+				description_valid(false)
+			{
+			}
+		};
+		OpenDevice m_open_device;
+		GtkWidget *m_live, *m_live_interval;
+		guint m_live_timer;
+		bool m_live_in_flight, m_live_values_valid, m_iconified;
+		uint8_t m_live_values;
+		TimelineView m_timeline;
+		GtkWidget *m_timeline_live;
+		string m_timeline_device;
+		gint64 m_timeline_start;
+		GtkWidget *m_dashboard, *m_dashboard_budget, *m_dashboard_status;
+		mcp2200::PollScheduler m_poll_scheduler;
+		guint m_dashboard_timer;
+		bool m_dashboard_in_flight;
+		map<string, mcp2200::Device> m_dashboard_devices;
+		unordered_map<string, GtkTreeIter> m_dashboard_rows;
+		const static uint64_t dashboard_min_interval = 100000;
 		GDBusObjectManager *m_manager;
 		thread m_usb_event_thread;
 		string m_current_device;
@@ -77,11 +142,34 @@ namespace gui
 		bool m_closing;
 		mutex m_before_close_mutex;
 		function<void()> m_before_close;
+		mcp2200::Udev *m_udev;
+		mcp2200::EventCoalescer<string, mcp2200::UdevEvent> m_usb_events;
+		const static guint usb_event_window = 100;
+		const static int dashboard_page = 4;
+		const static size_t apply_threads = 4;
+		const static int reconnect_timeout = 3000;
 		Impl(Program *decl):
 			m_decl(decl),
+			m_description_page_built(false),
+			m_configuration_page_built(false),
+			m_device_description_valid(false),
+			m_start_time(g_get_monotonic_time()),
+			m_devices_listed_time(0),
+			m_first_draw_handler(0),
+			m_operations(0),
+			m_live_timer(0),
+			m_live_in_flight(false),
+			m_live_values_valid(false),
+			m_iconified(false),
+			m_live_values(0),
+			m_timeline_start(0),
+			m_poll_scheduler(20, dashboard_min_interval),
+			m_dashboard_timer(0),
+			m_dashboard_in_flight(false),
 			m_manager(nullptr),
 			m_configuration_layout("Configuration"),
-			m_closing(false)
+			m_closing(false),
+			m_udev(nullptr)
 		{
 			m_configuration_layout
 				(new Uint16HexValue("vid", offsetof(Configuration, vid), mcp2200::defaultVendorId))
@@ -154,6 +242,12 @@ namespace gui
 				if (m_before_close)
 					m_before_close();
 			}
+			setLive(false);
+			setDashboardPolling(false);
+			m_apply_workers.stop();
+			m_worker.stop();
+			closeDevice();
+			m_dashboard_devices.clear();
 			m_usb_event_thread.join();
 			saveConfiguration();
 		}
@@ -191,11 +285,19 @@ namespace gui
 			gtk_widget_set_margin_top(widget, 5);
 			gtk_widget_set_margin_bottom(widget, 5);
 		}
-		void addColumn(GtkWidget *list, GtkListStore *, const char *title, DeviceColumn column)
+		template <typename Column>
+		void addColumn(GtkWidget *list, GtkListStore *, const char *title, Column column, int width = 0)
 		{
 			GtkTreeViewColumn *col = gtk_tree_view_column_new();
 			gtk_tree_view_column_set_title(col, title);
-			gtk_tree_view_column_set_sizing(col, GTK_TREE_VIEW_COLUMN_AUTOSIZE);
+			if (width > 0){
+				gtk_tree_view_column_set_sizing(col, GTK_TREE_VIEW_COLUMN_FIXED);
+				gtk_tree_view_column_set_fixed_width(col, width);
+				gtk_tree_view_column_set_resizable(col, true);
+			}else{
+				gtk_tree_view_column_set_sizing(col, GTK_TREE_VIEW_COLUMN_AUTOSIZE);
+			}
+			gtk_tree_view_column_set_sort_column_id(col, enum_value(column));
 			GtkCellRenderer *renderer = gtk_cell_renderer_text_new();
 			gtk_tree_view_column_pack_start(col, renderer, true);
 			gtk_tree_view_column_add_attribute(col, renderer, "text", enum_value(column));
@@ -219,26 +321,153 @@ namespace gui
 			gtk_tree_view_set_headers_visible(GTK_TREE_VIEW(list), true);
 			g_signal_connect(G_OBJECT(list), "cursor-changed", G_CALLBACK(onCursorChanged), this);
 			g_signal_connect(G_OBJECT(list), "row-activated", G_CALLBACK(onRowActivated), this);
-			GtkListStore *store = gtk_list_store_new(5, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_INT);
-			addColumn(list, store, "Path", DeviceColumn::path);
-			addColumn(list, store, "Serial", DeviceColumn::serial);
-			addColumn(list, store, "Manufacturer", DeviceColumn::manufacturer);
-			addColumn(list, store, "Product", DeviceColumn::product);
-			addColumn(list, store, "Release number", DeviceColumn::release_number);
+			gtk_tree_selection_set_mode(gtk_tree_view_get_selection(GTK_TREE_VIEW(list)), GTK_SELECTION_MULTIPLE);
+			// Fixed column widths and row height let the view measure only rows which are visible.
+			addColumn(list, nullptr, "Path", DeviceColumn::path, 120);
+			addColumn(list, nullptr, "Serial", DeviceColumn::serial, 110);
+			addColumn(list, nullptr, "Manufacturer", DeviceColumn::manufacturer, 200);
+			addColumn(list, nullptr, "Product", DeviceColumn::product, 240);
+			addColumn(list, nullptr, "Release number", DeviceColumn::release_number, 110);
+			addColumn(list, nullptr, "Status", DeviceColumn::status, 100);
+			gtk_tree_view_set_fixed_height_mode(GTK_TREE_VIEW(list), true);
 
 			gtk_tree_view_set_enable_search(GTK_TREE_VIEW(list), false);
-			gtk_tree_view_set_model(GTK_TREE_VIEW(list), GTK_TREE_MODEL(store));
-			g_object_unref(GTK_TREE_MODEL(store));
+			setDeviceModel(newDeviceStore());
 			GtkWidget *scrolled_window = createScrolledWindow();
 			gtk_container_add(GTK_CONTAINER(scrolled_window), list);
-			return scrolled_window;
+			m_device_search = gtk_search_entry_new();
+			gtk_entry_set_placeholder_text(GTK_ENTRY(m_device_search), "Search by path, serial, manufacturer or product");
+			g_signal_connect(m_device_search, "search-changed", G_CALLBACK(onDeviceSearchChanged), this);
+			// Placeholder is shown until the first enumeration running on the worker thread finishes.
+			GtkWidget *placeholder = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+			gtk_widget_set_halign(placeholder, GTK_ALIGN_CENTER);
+			GtkWidget *spinner = gtk_spinner_new();
+			gtk_spinner_start(GTK_SPINNER(spinner));
+			gtk_box_pack_start(GTK_BOX(placeholder), spinner, false, false, 0);
+			gtk_box_pack_start(GTK_BOX(placeholder), gtk_label_new("Searching for devices..."), false, false, 0);
+			m_device_list_stack = gtk_stack_new();
+			gtk_stack_add_named(GTK_STACK(m_device_list_stack), placeholder, "searching");
+			gtk_stack_add_named(GTK_STACK(m_device_list_stack), scrolled_window, "devices");
+			GtkWidget *vbox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 5);
+			gtk_box_pack_start(GTK_BOX(vbox), m_device_search, false, false, 0);
+			gtk_box_pack_start(GTK_BOX(vbox), m_device_list_stack, true, true, 0);
+			return vbox;
+		}
+		static GtkListStore *newDeviceStore()
+		{
+			return gtk_list_store_new(6, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_INT, G_TYPE_STRING);
+		}
+		// View shows the store through filter and sort models. A new store is filled before it is connected to them, so a full refresh does not emit signals for each row.
+		void setDeviceModel(GtkListStore *store)
+		{
+			gint sort_column = enum_value(DeviceColumn::path);
+			GtkSortType sort_order = GTK_SORT_ASCENDING;
+			GtkTreeModel *previous = gtk_tree_view_get_model(GTK_TREE_VIEW(m_device_list));
+			if (previous)
+				gtk_tree_sortable_get_sort_column_id(GTK_TREE_SORTABLE(previous), &sort_column, &sort_order);
+			m_device_store = store;
+			GtkTreeModel *filter = gtk_tree_model_filter_new(GTK_TREE_MODEL(store), nullptr);
+			gtk_tree_model_filter_set_visible_func(GTK_TREE_MODEL_FILTER(filter), (GtkTreeModelFilterVisibleFunc)&Impl::isDeviceVisible, this, nullptr);
+			m_device_filter_model = filter;
+			GtkTreeModel *sort = gtk_tree_model_sort_new_with_model(filter);
+			gtk_tree_sortable_set_sort_column_id(GTK_TREE_SORTABLE(sort), sort_column, sort_order);
+			gtk_tree_view_set_model(GTK_TREE_VIEW(m_device_list), sort);
+			g_object_unref(sort);
+			g_object_unref(filter);
+			g_object_unref(store);
+		}
+		void selectDevice(const string &path)
+		{
+			auto row = m_device_rows.find(path);
+			if (row == m_device_rows.end())
+				return;
+			GtkTreeIter filter_iter, sort_iter;
+			if (!gtk_tree_model_filter_convert_child_iter_to_iter(GTK_TREE_MODEL_FILTER(m_device_filter_model), &filter_iter, &row->second))
+				return;
+			GtkTreeModel *sort = gtk_tree_view_get_model(GTK_TREE_VIEW(m_device_list));
+			gtk_tree_model_sort_convert_child_iter_to_iter(GTK_TREE_MODEL_SORT(sort), &sort_iter, &filter_iter);
+			GtkTreeSelection *selection = gtk_tree_view_get_selection(GTK_TREE_VIEW(m_device_list));
+			gtk_tree_selection_unselect_all(selection);
+			gtk_tree_selection_select_iter(selection, &sort_iter);
+		}
+		static gboolean isDeviceVisible(GtkTreeModel *model, GtkTreeIter *iter, Impl *app)
+		{
+			if (app->m_device_filter.empty())
+				return true;
+			for (auto column: {DeviceColumn::path, DeviceColumn::serial, DeviceColumn::manufacturer, DeviceColumn::product}){
+				gchar *value = nullptr;
+				gtk_tree_model_get(model, iter, enum_value(column), &value, -1);
+				if (!value)
+					continue;
+				string text = value;
+				g_free(value);
+				transform(text.begin(), text.end(), text.begin(), [](unsigned char c){ return tolower(c); });
+				if (text.find(app->m_device_filter) != string::npos)
+					return true;
+			}
+			return false;
+		}
+		void setDeviceFilter(const string &filter)
+		{
+			m_device_filter = filter;
+			transform(m_device_filter.begin(), m_device_filter.end(), m_device_filter.begin(), [](unsigned char c){ return tolower(c); });
+			gtk_tree_model_filter_refilter(GTK_TREE_MODEL_FILTER(m_device_filter_model));
 		}
 		void addDevice(const mcp2200::DeviceInformation &device)
 		{
-			auto model = gtk_tree_view_get_model(GTK_TREE_VIEW(m_device_list));
 			GtkTreeIter iter;
-			gtk_list_store_append(GTK_LIST_STORE(model), &iter);
-			gtk_list_store_set(GTK_LIST_STORE(model), &iter,
+			gtk_list_store_append(m_device_store, &iter);
+			m_device_rows[device.path] = iter;
+			setDevice(iter, device);
+			addDashboardDevice(device);
+		}
+		// List store iterators stay valid while their row exists, so rows are found by path without scanning the list.
+		bool findDevice(const string &path, GtkTreeIter &iter)
+		{
+			auto row = m_device_rows.find(path);
+			if (row == m_device_rows.end())
+				return false;
+			iter = row->second;
+			return true;
+		}
+		void updateDevice(const mcp2200::DeviceInformation &device)
+		{
+			GtkTreeIter iter;
+			if (findDevice(device.path, iter)){
+				setDevice(iter, device);
+				addDashboardDevice(device);
+			}else{
+				addDevice(device);
+			}
+		}
+		void removeDevice(const string &path)
+		{
+			GtkTreeIter iter;
+			if (findDevice(path, iter)){
+				gtk_list_store_remove(m_device_store, &iter);
+				m_device_rows.erase(path);
+			}
+			removeDashboardDevice(path);
+		}
+		void applyUsbEvent(const mcp2200::UdevEvent &event)
+		{
+			// Monitor only passes events of devices matching configured vendor and product IDs, so the list is updated in place without enumerating all HID devices.
+			if (event.action == mcp2200::UdevEvent::Action::add){
+				mcp2200::DeviceInformation device(event.path.c_str(), event.serial.c_str(), event.manufacturer.c_str(), event.product.c_str(), event.release_number);
+				updateDevice(device);
+			}else{
+				removeDevice(event.path);
+				string path = event.path;
+				m_worker.post([this, path](){
+					if (m_open_device.path == path)
+						closeDevice();
+					m_dashboard_devices.erase(path);
+				});
+			}
+		}
+		void setDevice(GtkTreeIter &iter, const mcp2200::DeviceInformation &device)
+		{
+			gtk_list_store_set(m_device_store, &iter,
 				enum_value(DeviceColumn::path), device.path.c_str(),
 				enum_value(DeviceColumn::serial), device.serial.c_str(),
 				enum_value(DeviceColumn::manufacturer), device.manufacturer.c_str(),
@@ -246,22 +475,90 @@ namespace gui
 				enum_value(DeviceColumn::release_number), device.release_number,
 				-1);
 		}
-		void clearDevices()
+		void setDevices(const vector<mcp2200::DeviceInformation> &devices)
 		{
-			auto model = gtk_tree_view_get_model(GTK_TREE_VIEW(m_device_list));
-			gtk_list_store_clear(GTK_LIST_STORE(model));
+			GtkListStore *store = newDeviceStore();
+			m_device_rows.clear();
+			for (auto &device: devices){
+				GtkTreeIter iter;
+				gtk_list_store_insert_with_values(store, &iter, -1,
+					enum_value(DeviceColumn::path), device.path.c_str(),
+					enum_value(DeviceColumn::serial), device.serial.c_str(),
+					enum_value(DeviceColumn::manufacturer), device.manufacturer.c_str(),
+					enum_value(DeviceColumn::product), device.product.c_str(),
+					enum_value(DeviceColumn::release_number), device.release_number,
+					-1);
+				m_device_rows[device.path] = iter;
+			}
+			setDeviceModel(store);
+			setDashboardDevices(devices);
+			if (!m_devices_listed_time){
+				m_devices_listed_time = g_get_monotonic_time();
+				gtk_stack_set_visible_child_name(GTK_STACK(m_device_list_stack), "devices");
+				g_debug("device list ready %.1f ms after start, %zu devices", (m_devices_listed_time - m_start_time) / 1000.0, devices.size());
+			}
 		}
-		void showDevices()
+		struct UiCallback
 		{
-			mcp2200::Device device;
-			if (device.find(m_configuration.vid, m_configuration.pid)){
-				clearDevices();
+			function<void()> callback;
+		};
+		static gboolean onUiCallback(UiCallback *ui_callback)
+		{
+			ui_callback->callback();
+			delete ui_callback;
+			return false;
+		}
+		void beginOperation(const char *status)
+		{
+			if (m_operations++ == 0){
+				gtk_spinner_start(GTK_SPINNER(m_spinner));
+			}
+			gtk_label_set_text(GTK_LABEL(m_status), status);
+		}
+		void endOperation(bool success, const char *error)
+		{
+			if (--m_operations == 0){
+				gtk_spinner_stop(GTK_SPINNER(m_spinner));
+				gtk_label_set_text(GTK_LABEL(m_status), "");
+			}
+			if (!success){
+				gtk_label_set_text(GTK_LABEL(m_status), error);
+			}
+		}
+		// Runs job on the device worker thread and done on the main loop with the job result, so USB I/O never blocks the window.
+		template <typename Result, typename Job, typename Done>
+		void runInBackground(const char *status, const char *error, Job job, Done done)
+		{
+			beginOperation(status);
+			auto result = make_shared<Result>();
+			m_worker.post([this, result, job, done, error](){
+				bool success = job(*result);
+				g_idle_add((GSourceFunc)&Impl::onUiCallback, new UiCallback{[this, result, done, error, success](){
+					done(success, *result);
+					endOperation(success, error);
+				}});
+			});
+		}
+		void showDevices(const string &select = string())
+		{
+			uint16_t vid = m_configuration.vid, pid = m_configuration.pid;
+			runInBackground<vector<mcp2200::DeviceInformation>>("Searching for devices...", "Device search failed", [vid, pid](vector<mcp2200::DeviceInformation> &devices){
+				mcp2200::Device device;
+				device.find(vid, pid);
 				for (size_t i = 0; i < device.getCount(); i++){
-					addDevice(device[i]);
+					devices.push_back(device[i]);
 				}
-			}else{
-				clearDevices();
-			}
+#ifdef LINUX_BUILD
+				mcp2200::SerialIndex index;
+				if (index.open())
+					index.replace(vid, pid, devices);
+#endif
+				return true;
+			}, [this, select](bool, vector<mcp2200::DeviceInformation> &devices){
+				setDevices(devices);
+				if (!select.empty())
+					selectDevice(select);
+			});
 		}
 		void setCurrentState(const mcp2200::Command &state)
 		{
@@ -295,6 +592,8 @@ namespace gui
 					break;
 			}
 			uint8_t gpio = state.getGpioValues();
+			m_live_values = gpio;
+			m_live_values_valid = true;
 			uint8_t gpio_directions = state.getIoDirections();
 			uint8_t gpio_defaults = state.getDefaultValues();
 			uint8_t gpio_mask = state.getIoMask();
@@ -309,31 +608,338 @@ namespace gui
 				gtk_widget_set_sensitive(m_gpio[i].default_value, ((gpio_mask >> i) & 1) == 1);
 			}
 		}
-		bool openDevice(const char *device_path = nullptr)
+		struct DeviceState
+		{
+			string manufacturer, product;
+			mcp2200::Command response;
+			bool description_read;
+			DeviceState():
+				description_read(false)
+			{
+			}
+		};
+		// Selected device is kept open on the worker thread together with its last read state, and closed when it is unplugged.
+		bool useDevice(const string &path)
+		{
+			if (m_open_device.device.isOpen() && m_open_device.path == path){
+				return true;
+			}
+			closeDevice();
+			if (!m_open_device.device.open(path)){
+				return false;
+			}
+			m_open_device.path = path;
+			// Dashboard reads selected device through this handle, its own handle would only collect reports until deselection.
+			m_dashboard_devices.erase(path);
+			return true;
+		}
+		void closeDevice()
+		{
+			m_open_device.device.close();
+			m_open_device.path.clear();
+			m_open_device.state_valid = false;
+			m_open_device.description_valid = false;
+		}
+		bool readDevice(bool reload, DeviceState &state)
+		{
+			auto &open_device = m_open_device;
+			if (reload || !open_device.description_valid){
+				if (!open_device.device.getManufacturer(open_device.manufacturer) || !open_device.device.getProduct(open_device.product)){
+					return false;
+				}
+				open_device.description_valid = true;
+			}
+			state.manufacturer = open_device.manufacturer;
+			state.product = open_device.product;
+			state.description_read = true;
+			if (reload || !open_device.state_valid){
+				if (!open_device.device.readAll(open_device.state)){
+					return false;
+				}
+				open_device.state_valid = true;
+			}
+			state.response = open_device.state;
+			return true;
+		}
+		void openDevice(const char *device_path = nullptr, bool reload = true)
 		{
 			if (device_path){
 				m_current_device = device_path;
 			}
-			mcp2200::Device device;
-			if (!device.open(m_current_device.c_str())){
-				return false;
+			string path = m_current_device;
+			runInBackground<DeviceState>("Reading device...", "Could not read device", [this, path, reload](DeviceState &state){
+				if (!useDevice(path)){
+					return false;
+				}
+				if (!readDevice(reload, state)){
+					closeDevice();
+					return false;
+				}
+				return true;
+			}, [this](bool success, DeviceState &state){
+				if (state.description_read){
+					m_device_manufacturer = state.manufacturer;
+					m_device_product = state.product;
+					m_device_description_valid = true;
+					showDescription();
+				}
+				if (success){
+					setCurrentState(state.response);
+				}
+			});
+		}
+		void showDescription()
+		{
+			if (!m_description_page_built || !m_device_description_valid){
+				return;
 			}
-			std::string manufacturer, product;
-			device.getManufacturer(manufacturer);
-			device.getProduct(product);
 			string vid = toHexString(m_configuration.vid);
 			string pid = toHexString(m_configuration.pid);
 			gtk_entry_set_text(GTK_ENTRY(m_new_pid), pid.c_str());
 			gtk_entry_set_text(GTK_ENTRY(m_new_vid), vid.c_str());
-			gtk_entry_set_text(GTK_ENTRY(m_new_manufacturer), manufacturer.c_str());
-			gtk_entry_set_text(GTK_ENTRY(m_new_product), product.c_str());
-			mcp2200::Command response;
-			if (!device.readAll(response)){
+			gtk_entry_set_text(GTK_ENTRY(m_new_manufacturer), m_device_manufacturer.c_str());
+			gtk_entry_set_text(GTK_ENTRY(m_new_product), m_device_product.c_str());
+		}
+		void setLive(bool live)
+		{
+			if (m_live_timer){
+				g_source_remove(m_live_timer);
+				m_live_timer = 0;
+			}
+			if (live){
+				guint interval = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(m_live_interval));
+				m_live_timer = g_timeout_add(interval, (GSourceFunc)&Impl::onLiveTimer, this);
+			}
+		}
+		bool isLiveVisible()
+		{
+			// Value check boxes and the timeline are unmapped while another notebook page is shown.
+			return !m_iconified && (gtk_widget_get_mapped(m_gpio[0].value) || gtk_widget_get_mapped(m_timeline.getWidget()));
+		}
+		void pollGpioValues()
+		{
+			if (m_live_in_flight || m_current_device.empty() || !isLiveVisible()){
+				return;
+			}
+			string path = m_current_device;
+			m_live_in_flight = m_worker.post([this, path](){
+				auto &open_device = m_open_device;
+				bool success = useDevice(path) && open_device.device.readAll(open_device.state);
+				gint64 time = g_get_monotonic_time();
+				uint8_t values = 0;
+				if (success){
+					open_device.state_valid = true;
+					values = open_device.state.getGpioValues();
+				}else{
+					closeDevice();
+				}
+				g_idle_add((GSourceFunc)&Impl::onUiCallback, new UiCallback{[this, path, success, values, time](){
+					m_live_in_flight = false;
+					if (success && path == m_current_device){
+						updateGpioValues(values);
+						appendTimelineSample(path, time, values);
+					}
+				}});
+			});
+		}
+		void updateGpioValues(uint8_t values)
+		{
+			uint8_t changed = m_live_values_valid ? values ^ m_live_values : 0xff;
+			for (int i = 0; i < 8; i++){
+				if ((changed >> i) & 1){
+					gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(m_gpio[i].value), ((values >> i) & 1) == 1);
+				}
+			}
+			m_live_values = values;
+			m_live_values_valid = true;
+		}
+		void appendTimelineSample(const string &path, gint64 time, uint8_t values)
+		{
+			auto &samples = m_timeline.getSamples();
+			if (path != m_timeline_device || samples.empty()){
+				m_timeline.clear();
+				m_timeline_device = path;
+				m_timeline_start = time;
+			}
+			uint64_t time_us = time - m_timeline_start;
+			// Only changes are stored, polls without a change just extend the last value.
+			if (samples.empty() || samples.getValue(samples.size() - 1) != values)
+				m_timeline.append(time_us, values);
+			else
+				m_timeline.extend(time_us);
+		}
+		void openCapture()
+		{
+			GtkWidget *dialog = gtk_file_chooser_dialog_new("Open capture", GTK_WINDOW(m_window), GTK_FILE_CHOOSER_ACTION_OPEN, "_Cancel", GTK_RESPONSE_CANCEL, "_Open", GTK_RESPONSE_ACCEPT, nullptr);
+			if (gtk_dialog_run(GTK_DIALOG(dialog)) == GTK_RESPONSE_ACCEPT){
+				gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(m_live), false);
+				char *filename = gtk_file_chooser_get_filename(GTK_FILE_CHOOSER(dialog));
+				m_timeline_device.clear();
+				if (m_timeline.load(filename)){
+					string status = to_string(m_timeline.getSamples().size()) + " samples loaded";
+					gtk_label_set_text(GTK_LABEL(m_status), status.c_str());
+				}else{
+					gtk_label_set_text(GTK_LABEL(m_status), "Could not load capture");
+				}
+				g_free(filename);
+			}
+			gtk_widget_destroy(dialog);
+		}
+		GtkWidget *createDashboard()
+		{
+			m_dashboard = gtk_tree_view_new();
+			gtk_tree_view_set_headers_visible(GTK_TREE_VIEW(m_dashboard), true);
+			GtkListStore *store = gtk_list_store_new(9, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING, G_TYPE_STRING);
+			addColumn(m_dashboard, store, "Path", DashboardColumn::path);
+			addColumn(m_dashboard, store, "Serial", DashboardColumn::serial);
+			addColumn(m_dashboard, store, "Product", DashboardColumn::product);
+			addColumn(m_dashboard, store, "GPIO values", DashboardColumn::gpio);
+			addColumn(m_dashboard, store, "Directions", DashboardColumn::directions);
+			addColumn(m_dashboard, store, "Receive LED", DashboardColumn::rx_led);
+			addColumn(m_dashboard, store, "Transmit LED", DashboardColumn::tx_led);
+			addColumn(m_dashboard, store, "Baud rate", DashboardColumn::baud_rate);
+			addColumn(m_dashboard, store, "Options", DashboardColumn::options);
+			gtk_tree_view_set_model(GTK_TREE_VIEW(m_dashboard), GTK_TREE_MODEL(store));
+			g_object_unref(GTK_TREE_MODEL(store));
+			GtkWidget *scrolled_window = createScrolledWindow();
+			gtk_container_add(GTK_CONTAINER(scrolled_window), m_dashboard);
+			return scrolled_window;
+		}
+		void addDashboardDevice(const mcp2200::DeviceInformation &device)
+		{
+			auto model = gtk_tree_view_get_model(GTK_TREE_VIEW(m_dashboard));
+			GtkTreeIter iter;
+			auto row = m_dashboard_rows.find(device.path);
+			if (row == m_dashboard_rows.end()){
+				gtk_list_store_append(GTK_LIST_STORE(model), &iter);
+				m_dashboard_rows[device.path] = iter;
+			}else{
+				iter = row->second;
+			}
+			gtk_list_store_set(GTK_LIST_STORE(model), &iter,
+				enum_value(DashboardColumn::path), device.path.c_str(),
+				enum_value(DashboardColumn::serial), device.serial.c_str(),
+				enum_value(DashboardColumn::product), device.product.c_str(),
+				-1);
+			m_poll_scheduler.add(device.path);
+			updateDashboardStatus();
+		}
+		void removeDashboardDevice(const string &path)
+		{
+			auto model = gtk_tree_view_get_model(GTK_TREE_VIEW(m_dashboard));
+			auto row = m_dashboard_rows.find(path);
+			if (row != m_dashboard_rows.end()){
+				gtk_list_store_remove(GTK_LIST_STORE(model), &row->second);
+				m_dashboard_rows.erase(row);
+			}
+			m_poll_scheduler.remove(path);
+			updateDashboardStatus();
+		}
+		void setDashboardDevices(const vector<mcp2200::DeviceInformation> &devices)
+		{
+			auto model = gtk_tree_view_get_model(GTK_TREE_VIEW(m_dashboard));
+			g_object_ref(model);
+			gtk_tree_view_set_model(GTK_TREE_VIEW(m_dashboard), nullptr);
+			gtk_list_store_clear(GTK_LIST_STORE(model));
+			m_dashboard_rows.clear();
+			m_poll_scheduler.clear();
+			for (auto &device: devices){
+				GtkTreeIter iter;
+				gtk_list_store_insert_with_values(GTK_LIST_STORE(model), &iter, -1,
+					enum_value(DashboardColumn::path), device.path.c_str(),
+					enum_value(DashboardColumn::serial), device.serial.c_str(),
+					enum_value(DashboardColumn::product), device.product.c_str(),
+					-1);
+				m_dashboard_rows[device.path] = iter;
+				m_poll_scheduler.add(device.path);
+			}
+			gtk_tree_view_set_model(GTK_TREE_VIEW(m_dashboard), model);
+			g_object_unref(model);
+			updateDashboardStatus();
+			m_worker.post([this](){
+				m_dashboard_devices.clear();
+			});
+		}
+		void updateDashboardStatus()
+		{
+			stringstream status;
+			status << m_poll_scheduler.size() << " devices, each read every " << m_poll_scheduler.getDeviceInterval() / 1000 << " ms";
+			gtk_label_set_text(GTK_LABEL(m_dashboard_status), status.str().c_str());
+		}
+		void setDashboardPolling(bool polling)
+		{
+			if (m_dashboard_timer){
+				g_source_remove(m_dashboard_timer);
+				m_dashboard_timer = 0;
+			}
+			if (polling){
+				// Timer only offers transactions, the scheduler decides whether the budget allows one and which device gets it.
+				guint interval = max(1, static_cast<int>(1000 / m_poll_scheduler.getBudget()));
+				m_dashboard_timer = g_timeout_add(interval, (GSourceFunc)&Impl::onDashboardTimer, this);
+			}
+		}
+		// Dashboard reuses the handle of the selected device and keeps its own handles for all other devices, all of them are used only on the worker thread.
+		bool readDashboardDevice(const string &path, mcp2200::Command &state)
+		{
+			if (m_open_device.device.isOpen() && m_open_device.path == path){
+				if (!m_open_device.device.readAll(m_open_device.state)){
+					closeDevice();
+					return false;
+				}
+				m_open_device.state_valid = true;
+				state = m_open_device.state;
+				return true;
+			}
+			auto &device = m_dashboard_devices[path];
+			if ((!device.isOpen() && !device.open(path)) || !device.readAll(state)){
+				m_dashboard_devices.erase(path);
 				return false;
 			}
-			setCurrentState(response);
 			return true;
 		}
+		void pollDashboard()
+		{
+			string path;
+			if (m_dashboard_in_flight || m_iconified || !m_poll_scheduler.next(g_get_monotonic_time(), path)){
+				return;
+			}
+			m_dashboard_in_flight = m_worker.post([this, path](){
+				mcp2200::Command state;
+				bool success = readDashboardDevice(path, state);
+				g_idle_add((GSourceFunc)&Impl::onUiCallback, new UiCallback{[this, path, success, state](){
+					m_dashboard_in_flight = false;
+					setDashboardState(path, success, state);
+				}});
+			});
+		}
+		void setDashboardState(const string &path, bool success, const mcp2200::Command &state)
+		{
+			using command_line::operator<<;
+			auto model = gtk_tree_view_get_model(GTK_TREE_VIEW(m_dashboard));
+			auto row = m_dashboard_rows.find(path);
+			if (row == m_dashboard_rows.end())
+				return;
+			GtkTreeIter &iter = row->second;
+			if (!success){
+				gtk_list_store_set(GTK_LIST_STORE(model), &iter, enum_value(DashboardColumn::gpio), "error", -1);
+				return;
+			}
+			stringstream gpio, directions, rx_led, tx_led, options;
+			gpio << command_line::BitMap<uint8_t>(state.getGpioValues());
+			directions << command_line::BitMap<uint8_t>(state.getIoDirections(), 'o', 'i');
+			rx_led << state.getRxLedMode();
+			tx_led << state.getTxLedMode();
+			options << (state.getInvert() ? "invert " : "") << (state.getFlowControl() ? "flow-control " : "") << (state.getSuspend() ? "suspend " : "") << (state.getUsbConfigure() ? "configure " : "") << (state.getBlinkSpeed() ? "slow-blink" : "fast-blink");
+			string baud_rate = to_string(state.getBaudRate());
+			gtk_list_store_set(GTK_LIST_STORE(model), &iter,
+				enum_value(DashboardColumn::gpio), gpio.str().c_str(),
+				enum_value(DashboardColumn::directions), directions.str().c_str(),
+				enum_value(DashboardColumn::rx_led), rx_led.str().c_str(),
+				enum_value(DashboardColumn::tx_led), tx_led.str().c_str(),
+				enum_value(DashboardColumn::baud_rate), baud_rate.c_str(),
+				enum_value(DashboardColumn::options), options.str().c_str(),
+				-1);
+		}
 		mcp2200::LedMode getLedMode(GtkWidget **widgets)
 		{
 			if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(widgets[1])))
@@ -343,51 +949,63 @@ namespace gui
 			else
 				return mcp2200::LedMode::off;
 		}
-		void toCommand(mcp2200::Command &command)
+		struct Settings
+		{
+			bool suspend, usb_configure, invert, flow_control, fast_blink;
+			mcp2200::LedMode rx_mode, tx_mode;
+			uint8_t gpio, gpio_directions, gpio_defaults;
+		};
+		Settings getSettings()
+		{
+			Settings settings;
+			settings.suspend = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_suspend));
+			settings.usb_configure = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_usb_configure));
+			settings.invert = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_invert));
+			settings.flow_control = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_flow_control));
+			settings.fast_blink = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_fast_blink));
+			settings.rx_mode = getLedMode(m_rx);
+			settings.tx_mode = getLedMode(m_tx);
+			settings.gpio = settings.gpio_directions = settings.gpio_defaults = 0;
+			for (int i = 0; i < 8; i++){
+				settings.gpio |= gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_gpio[i].value)) << i;
+				settings.gpio_directions |= gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_gpio[i].input)) << i;
+				settings.gpio_defaults |= gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_gpio[i].default_value)) << i;
+			}
+			return settings;
+		}
+		static void toCommand(const Settings &settings, mcp2200::Command &command)
 		{
 			using namespace mcp2200;
 			command.setCommand(CommandType::configure);
 			command
-				.setSuspend(gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_suspend)))
-				.setUsbConfigure(gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_usb_configure)))
-				.setInvert(gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_invert)))
-				.setFlowControl(gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_flow_control)))
-				.setBlinkSpeed(!gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_fast_blink)));
-			auto rx_mode = getLedMode(m_rx);
-			if (rx_mode != LedMode::off)
-				command.setRxLedMode(rx_mode);
-			auto tx_mode = getLedMode(m_tx);
-			if (tx_mode != LedMode::off)
-				command.setTxLedMode(tx_mode);
+				.setSuspend(settings.suspend)
+				.setUsbConfigure(settings.usb_configure)
+				.setInvert(settings.invert)
+				.setFlowControl(settings.flow_control)
+				.setBlinkSpeed(!settings.fast_blink);
+			if (settings.rx_mode != LedMode::off)
+				command.setRxLedMode(settings.rx_mode);
+			if (settings.tx_mode != LedMode::off)
+				command.setTxLedMode(settings.tx_mode);
 			uint8_t gpio_mask = command.getIoMask();
-			uint8_t gpio = 0, gpio_directions = 0, gpio_defaults = 0;
-			for (int i = 0; i < 8; i++){
-				gpio |= gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_gpio[i].value)) << i;
-				gpio_directions |= gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_gpio[i].input)) << i;
-				gpio_defaults |= gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_gpio[i].default_value)) << i;
-			}
 			command
-				.setGpioValues(gpio & gpio_mask, ~gpio & gpio_mask)
-				.setDefaultValues((gpio_defaults & gpio_mask) | (command.getDefaultValues() & ~gpio_mask))
-				.setIoDirections((gpio_directions & gpio_mask) | (command.getIoDirections() & ~gpio_mask));
+				.setGpioValues(settings.gpio & gpio_mask, ~settings.gpio & gpio_mask)
+				.setDefaultValues((settings.gpio_defaults & gpio_mask) | (command.getDefaultValues() & ~gpio_mask))
+				.setIoDirections((settings.gpio_directions & gpio_mask) | (command.getIoDirections() & ~gpio_mask));
 		}
-		void toGpioValuesCommand(mcp2200::Command &command)
+		static void toGpioValuesCommand(const Settings &settings, mcp2200::Command &command)
 		{
 			using namespace mcp2200;
 			uint8_t gpio_mask = command.getIoMask();
-			uint8_t gpio = 0;
-			for (int i = 0; i < 8; i++){
-				gpio |= gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(m_gpio[i].value)) << i;
-			}
 			command
 				.setCommand(CommandType::set_clear_outputs)
-				.setGpioValues(gpio & gpio_mask, ~gpio & gpio_mask);
+				.setGpioValues(settings.gpio & gpio_mask, ~settings.gpio & gpio_mask);
 		}
 		void getGpioMask()
 		{
 			using namespace mcp2200;
 			Command command;
-			toCommand(command);
+			toCommand(getSettings(), command);
 			uint8_t gpio_mask = command.getIoMask();
 			for (int i = 0; i < 8; i++){
 				gtk_widget_set_sensitive(m_gpio[i].value, ((gpio_mask >> i) & 1) == 1);
@@ -396,74 +1014,149 @@ namespace gui
 				gtk_widget_set_sensitive(m_gpio[i].default_value, ((gpio_mask >> i) & 1) == 1);
 			}
 		}
-		bool openCurrentDevicePath(mcp2200::Device &device)
+		bool getCurrentDevicePath(string &current_device_path)
 		{
-			string current_device_path;
 			GtkTreePath *path;
 			gtk_tree_view_get_cursor(GTK_TREE_VIEW(m_device_list), &path, nullptr);
-			if (path != nullptr){
-				GtkTreeModel* model = gtk_tree_view_get_model(GTK_TREE_VIEW(m_device_list));
+			if (path == nullptr){
+				return false;
+			}
+			GtkTreeModel* model = gtk_tree_view_get_model(GTK_TREE_VIEW(m_device_list));
+			GtkTreeIter iter;
+			gtk_tree_model_get_iter(model, &iter, path);
+			gchar *device_path = nullptr;
+			gtk_tree_model_get(model, &iter, enum_value(DeviceColumn::path), &device_path, -1);
+			gtk_tree_path_free(path);
+			if (!device_path){
+				return false;
+			}
+			current_device_path = device_path;
+			g_free(device_path);
+			return true;
+		}
+		vector<string> getSelectedDevicePaths()
+		{
+			vector<string> paths;
+			GtkTreeModel *model;
+			GList *rows = gtk_tree_selection_get_selected_rows(gtk_tree_view_get_selection(GTK_TREE_VIEW(m_device_list)), &model);
+			for (GList *row = rows; row; row = row->next){
 				GtkTreeIter iter;
-				gtk_tree_model_get_iter(model, &iter, path);
+				if (!gtk_tree_model_get_iter(model, &iter, static_cast<GtkTreePath *>(row->data)))
+					continue;
 				gchar *device_path = nullptr;
 				gtk_tree_model_get(model, &iter, enum_value(DeviceColumn::path), &device_path, -1);
 				if (device_path){
-					current_device_path = device_path;
+					paths.push_back(device_path);
 					g_free(device_path);
-				}else{
-					gtk_tree_path_free(path);
-					return false;
 				}
-				gtk_tree_path_free(path);
-			}
-			if (!device.open(current_device_path.c_str())){
-				return false;
 			}
-			return true;
+			g_list_free_full(rows, (GDestroyNotify)gtk_tree_path_free);
+			return paths;
 		}
-		bool applyToDevice()
+		void setDeviceStatus(const string &path, const char *status)
 		{
-			using namespace mcp2200;
-			Device device;
-			if (!openCurrentDevicePath(device)){
-				return false;
-			}
-			Command response;
-			if (!device.readAll(response)){
-				return false;
-			}
-			Command command(response);
-			toCommand(command);
-			if (!device.write(command)){
-				return false;
-			}
-			if (!device.readAll(response)){
-				return false;
+			GtkTreeIter iter;
+			if (findDevice(path, iter)){
+				gtk_list_store_set(m_device_store, &iter, enum_value(DeviceColumn::status), status, -1);
 			}
-			setCurrentState(response);
-			return true;
 		}
-		bool applyGpioValuesToDevice()
+		// Runs on one of the apply threads with a separate handle, so several devices can be written at the same time. Reports
+		// this causes on handles held by the worker are dropped by readAll before their next poll.
+		template <typename ToCommand>
+		static bool writeDevice(const string &path, const Settings &settings, ToCommand toCommand, mcp2200::Command &state)
 		{
-			using namespace mcp2200;
-			Device device;
-			if (!openCurrentDevicePath(device)){
+			mcp2200::Device device;
+			if (!device.open(path) || !device.readAll(state)){
 				return false;
 			}
-			Command response;
-			if (!device.readAll(response)){
-				return false;
+			mcp2200::Command command(state);
+			toCommand(settings, command);
+			return device.write(command) && device.readAll(state);
+		}
+		struct ApplyBatch
+		{
+			size_t count, remaining, failed;
+		};
+		template <typename ToCommand>
+		void writeToDevices(const char *status, const vector<string> &paths, ToCommand toCommand)
+		{
+			Settings settings = getSettings();
+			beginOperation(status);
+			auto batch = make_shared<ApplyBatch>(ApplyBatch{paths.size(), paths.size(), 0});
+			for (auto &path: paths){
+				setDeviceStatus(path, "Waiting");
+				m_apply_workers.post([this, path, settings, toCommand, batch](){
+					g_idle_add((GSourceFunc)&Impl::onUiCallback, new UiCallback{[this, path](){
+						setDeviceStatus(path, "Applying...");
+					}});
+					mcp2200::Command state;
+					bool success = writeDevice(path, settings, toCommand, state);
+					// Cached state of the selected device handle is stale after a write through another handle.
+					m_worker.post([this, path](){
+						if (m_open_device.path == path)
+							m_open_device.state_valid = false;
+					});
+					g_idle_add((GSourceFunc)&Impl::onUiCallback, new UiCallback{[this, path, success, state, batch](){
+						setDeviceStatus(path, success ? "Applied" : "Failed");
+						if (!success){
+							batch->failed++;
+						}else if (path == m_current_device){
+							setCurrentState(state);
+						}
+						if (--batch->remaining == 0){
+							string error = "Could not write to " + to_string(batch->failed) + " of " + to_string(batch->count) + " devices";
+							endOperation(batch->failed == 0, error.c_str());
+						}
+					}});
+				});
 			}
-			Command command(response);
-			toGpioValuesCommand(command);
-			if (!device.write(command)){
-				return false;
+		}
+		template <typename ToCommand>
+		void writeToDevice(const char *status, ToCommand toCommand)
+		{
+			auto paths = getSelectedDevicePaths();
+			if (paths.size() > 1){
+				writeToDevices(status, paths, toCommand);
+				return;
 			}
-			if (!device.readAll(response)){
-				return false;
+			string path;
+			if (!getCurrentDevicePath(path)){
+				return;
 			}
-			setCurrentState(response);
-			return true;
+			Settings settings = getSettings();
+			runInBackground<mcp2200::Command>(status, "Could not write to device", [this, path, settings, toCommand](mcp2200::Command &response){
+				using namespace mcp2200;
+				if (!useDevice(path)){
+					return false;
+				}
+				auto &open_device = m_open_device;
+				if (!open_device.state_valid && !open_device.device.readAll(open_device.state)){
+					closeDevice();
+					return false;
+				}
+				Command command(open_device.state);
+				toCommand(settings, command);
+				open_device.state_valid = false;
+				if (!open_device.device.write(command) || !open_device.device.readAll(open_device.state)){
+					closeDevice();
+					return false;
+				}
+				open_device.state_valid = true;
+				response = open_device.state;
+				return true;
+			}, [this](bool success, mcp2200::Command &response){
+				if (success){
+					setCurrentState(response);
+				}
+			});
+		}
+		void applyToDevice()
+		{
+			writeToDevice("Applying configuration...", &Impl::toCommand);
+		}
+		void applyGpioValuesToDevice()
+		{
+			writeToDevice("Applying GPIO values...", &Impl::toGpioValuesCommand);
 		}
 		void addCheckbox(GtkWidget *grid, int position, int column, const char *label, GtkWidget **checkbox, bool expand = true, bool center = false, void(*toggle)(GtkWidget*, Impl*) = nullptr)
 		{
@@ -547,17 +1240,85 @@ namespace gui
 			s >> hex >> result;
 			return result;
 		}
-		GtkWidget *addPageWithGrid(const char *label)
+		GtkWidget *addPage(const char *label)
 		{
 			GtkWidget *vbox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 0);
 			setMargins(vbox);
 			gtk_notebook_append_page(GTK_NOTEBOOK(m_notebook), vbox, gtk_label_new(label));
+			return vbox;
+		}
+		GtkWidget *addGrid(GtkWidget *vbox)
+		{
 			GtkWidget *grid = gtk_grid_new();
 			gtk_grid_set_column_spacing(GTK_GRID(grid), 10);
 			gtk_grid_set_row_spacing(GTK_GRID(grid), 2);
 			gtk_box_pack_start(GTK_BOX(vbox), grid, false, true, 10);
 			return grid;
 		}
+		void buildDescriptionPage()
+		{
+			GtkWidget *vbox = m_description_page;
+			GtkWidget *grid = addGrid(vbox);
+			gtk_widget_set_vexpand(grid, false);
+			gtk_box_pack_start(GTK_BOX(vbox), m_description_device_holder = gtk_box_new(GTK_ORIENTATION_VERTICAL, 0), true, true, 0);
+			gtk_box_reorder_child(GTK_BOX(vbox), grid, 1);
+
+			addLabel(grid, 0, 0, "Vendor ID", nullptr, false);
+			addEntry(grid, 0, 1, "", &m_new_vid, true);
+			addLabel(grid, 1, 0, "Product ID", nullptr, false);
+			addEntry(grid, 1, 1, "", &m_new_pid, true);
+			addLabel(grid, 2, 0, "Product", nullptr, false);
+			addEntry(grid, 2, 1, "", &m_new_product, true);
+			addLabel(grid, 3, 0, "Manufacturer", nullptr, false);
+			addEntry(grid, 3, 1, "", &m_new_manufacturer, true);
+
+			GtkWidget *hbox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+			gtk_box_pack_start(GTK_BOX(vbox), hbox, false, true, 0);
+			gtk_widget_set_halign(hbox, GTK_ALIGN_END);
+
+			GtkWidget *apply = gtk_button_new_with_label("Apply");
+			g_signal_connect(apply, "clicked", G_CALLBACK(onDescriptionApply), this);
+			gtk_box_pack_start(GTK_BOX(hbox), apply, false, false, 0);
+			GtkWidget *load_defaults = gtk_button_new_with_label("Load defaults");
+			g_signal_connect(load_defaults, "clicked", G_CALLBACK(onLoadDefaults), this);
+			gtk_box_pack_start(GTK_BOX(hbox), load_defaults, false, false, 0);
+			GtkWidget *reload = gtk_button_new_with_label("Reload");
+			g_signal_connect(reload, "clicked", G_CALLBACK(onReload), this);
+			gtk_box_pack_start(GTK_BOX(hbox), reload, false, false, 0);
+			GtkWidget *refresh = gtk_button_new_with_label("Refresh device list");
+			g_signal_connect(refresh, "clicked", G_CALLBACK(onRefresh), this);
+			gtk_box_pack_start(GTK_BOX(hbox), refresh, false, false, 0);
+			showDescription();
+			gtk_widget_show_all(vbox);
+			m_description_page_built = true;
+		}
+		void buildConfigurationPage()
+		{
+			GtkWidget *vbox = m_configuration_page;
+			GtkWidget *grid = addGrid(vbox);
+			gtk_widget_set_vexpand(grid, true);
+			string vid = toHexString(m_configuration.vid);
+			string pid = toHexString(m_configuration.pid);
+
+			addLabel(grid, 0, 0, "Vendor ID", nullptr, false);
+			addEntry(grid, 0, 1, vid.c_str(), &m_vid, true);
+			addLabel(grid, 1, 0, "Product ID", nullptr, false);
+			addEntry(grid, 1, 1, pid.c_str(), &m_pid, true);
+			addLabel(grid, 2, 0, "Default product", nullptr, false);
+			addEntry(grid, 2, 1, m_configuration.product.c_str(), &m_product, true);
+			addLabel(grid, 3, 0, "Default manufacturer", nullptr, false);
+			addEntry(grid, 3, 1, m_configuration.manufacturer.c_str(), &m_manufacturer, true);
+
+			GtkWidget *hbox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+			gtk_box_pack_start(GTK_BOX(vbox), hbox, false, true, 0);
+			gtk_widget_set_halign(hbox, GTK_ALIGN_END);
+
+			GtkWidget *apply = gtk_button_new_with_label("Apply");
+			g_signal_connect(apply, "clicked", G_CALLBACK(onConfigurationApply), this);
+			gtk_box_pack_start(GTK_BOX(hbox), apply, false, false, 0);
+			gtk_widget_show_all(vbox);
+			m_configuration_page_built = true;
+		}
 		int run(int, char **)
 		{
 			gtk_init(nullptr, nullptr);
@@ -565,15 +1326,18 @@ namespace gui
 			gtk_window_set_title(GTK_WINDOW(m_window), "MCP2200 Configuration");
 			g_signal_connect(G_OBJECT(m_window), "delete_event", G_CALLBACK(onDeleteEvent), this);
 			g_signal_connect(G_OBJECT(m_window), "destroy", G_CALLBACK(onDestroy), this);
+			g_signal_connect(G_OBJECT(m_window), "window-state-event", G_CALLBACK(onWindowState), this);
+			m_first_draw_handler = g_signal_connect_after(G_OBJECT(m_window), "draw", G_CALLBACK(onFirstDraw), this);
 			gtk_window_resize(GTK_WINDOW(m_window), 640, 540);
 			GtkWidget* vbox_main = gtk_box_new(GTK_ORIENTATION_VERTICAL, 5);
 			createMainMenu();
 			gtk_box_pack_start(GTK_BOX(vbox_main), m_menu, false, false, 0);
 			m_notebook = gtk_notebook_new();
 
-			GtkWidget *grid = addPageWithGrid("Properties");
-			GtkWidget *vbox = gtk_widget_get_parent(grid);
-			gtk_box_pack_start(GTK_BOX(vbox), m_device_scrolled_widget = createDeviceList(&m_device_list), true, true, 0);
+			GtkWidget *vbox = addPage("Properties");
+			GtkWidget *grid = addGrid(vbox);
+			gtk_box_pack_start(GTK_BOX(vbox), m_device_holder = gtk_box_new(GTK_ORIENTATION_VERTICAL, 0), true, true, 0);
+			gtk_box_pack_start(GTK_BOX(m_device_holder), m_device_list_box = createDeviceList(&m_device_list), true, true, 0);
 			gtk_box_reorder_child(GTK_BOX(vbox), grid, 1);
 
 			addLabel(grid, 0, 0, "Options");
@@ -617,6 +1381,15 @@ namespace gui
 			gtk_box_pack_start(GTK_BOX(vbox), hbox, false, true, 0);
 			gtk_widget_set_halign(hbox, GTK_ALIGN_END);
 
+			m_live = gtk_check_button_new_with_label("Live, refresh every");
+			g_signal_connect(m_live, "toggled", G_CALLBACK(onLiveToggled), this);
+			gtk_box_pack_start(GTK_BOX(hbox), m_live, false, false, 0);
+			m_live_interval = gtk_spin_button_new_with_range(10, 5000, 10);
+			gtk_spin_button_set_value(GTK_SPIN_BUTTON(m_live_interval), 100);
+			g_signal_connect(m_live_interval, "value-changed", G_CALLBACK(onLiveIntervalChanged), this);
+			gtk_box_pack_start(GTK_BOX(hbox), m_live_interval, false, false, 0);
+			gtk_box_pack_start(GTK_BOX(hbox), gtk_label_new("ms"), false, false, 0);
+
 			GtkWidget *apply = gtk_button_new_with_label("Apply");
 			g_signal_connect(apply, "clicked", G_CALLBACK(onApply), this);
 			gtk_box_pack_start(GTK_BOX(hbox), apply, false, false, 0);
@@ -630,64 +1403,64 @@ namespace gui
 			g_signal_connect(refresh, "clicked", G_CALLBACK(onRefresh), this);
 			gtk_box_pack_start(GTK_BOX(hbox), refresh, false, false, 0);
 
-			grid = addPageWithGrid("Description");
-			gtk_widget_set_vexpand(grid, false);
-			vbox = gtk_widget_get_parent(grid);
-			gtk_box_pack_start(GTK_BOX(vbox), m_description_scrolled_widget = createScrolledWindow(), true, true, 0);
-			gtk_box_reorder_child(GTK_BOX(vbox), grid, 1);
+			// Description and Configuration pages are rarely used, their contents are built when they are shown for the first time.
+			m_description_page = addPage("Description");
+			m_configuration_page = addPage("Configuration");
 
-			addLabel(grid, 0, 0, "Vendor ID", nullptr, false);
-			addEntry(grid, 0, 1, "", &m_new_vid, true);
-			addLabel(grid, 1, 0, "Product ID", nullptr, false);
-			addEntry(grid, 1, 1, "", &m_new_pid, true);
-			addLabel(grid, 2, 0, "Product", nullptr, false);
-			addEntry(grid, 2, 1, "", &m_new_product, true);
-			addLabel(grid, 3, 0, "Manufacturer", nullptr, false);
-			addEntry(grid, 3, 1, "", &m_new_manufacturer, true);
+			vbox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 5);
+			setMargins(vbox);
+			gtk_notebook_append_page(GTK_NOTEBOOK(m_notebook), vbox, gtk_label_new("Timeline"));
+			gtk_box_pack_start(GTK_BOX(vbox), m_timeline.create(), true, true, 0);
 
 			hbox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
 			gtk_box_pack_start(GTK_BOX(vbox), hbox, false, true, 0);
 			gtk_widget_set_halign(hbox, GTK_ALIGN_END);
 
-			apply = gtk_button_new_with_label("Apply");
-			g_signal_connect(apply, "clicked", G_CALLBACK(onDescriptionApply), this);
-			gtk_box_pack_start(GTK_BOX(hbox), apply, false, false, 0);
-			GtkWidget *load_defaults = gtk_button_new_with_label("Load defaults");
-			g_signal_connect(load_defaults, "clicked", G_CALLBACK(onLoadDefaults), this);
-			gtk_box_pack_start(GTK_BOX(hbox), load_defaults, false, false, 0);
-			reload = gtk_button_new_with_label("Reload");
-			g_signal_connect(reload, "clicked", G_CALLBACK(onReload), this);
-			gtk_box_pack_start(GTK_BOX(hbox), reload, false, false, 0);
-			refresh = gtk_button_new_with_label("Refresh device list");
-			g_signal_connect(refresh, "clicked", G_CALLBACK(onRefresh), this);
-			gtk_box_pack_start(GTK_BOX(hbox), refresh, false, false, 0);
-
-			grid = addPageWithGrid("Configuration");
-			gtk_widget_set_vexpand(grid, true);
-			vbox = gtk_widget_get_parent(grid);
-			string vid = toHexString(m_configuration.vid);
-			string pid = toHexString(m_configuration.pid);
+			m_timeline_live = gtk_check_button_new_with_label("Live");
+			g_signal_connect(m_timeline_live, "toggled", G_CALLBACK(onTimelineLiveToggled), this);
+			gtk_box_pack_start(GTK_BOX(hbox), m_timeline_live, false, false, 0);
+			GtkWidget *open_capture = gtk_button_new_with_label("Open capture");
+			g_signal_connect(open_capture, "clicked", G_CALLBACK(onOpenCapture), this);
+			gtk_box_pack_start(GTK_BOX(hbox), open_capture, false, false, 0);
+			GtkWidget *show_all = gtk_button_new_with_label("Show all");
+			g_signal_connect(show_all, "clicked", G_CALLBACK(onTimelineShowAll), this);
+			gtk_box_pack_start(GTK_BOX(hbox), show_all, false, false, 0);
+			GtkWidget *clear = gtk_button_new_with_label("Clear");
+			g_signal_connect(clear, "clicked", G_CALLBACK(onTimelineClear), this);
+			gtk_box_pack_start(GTK_BOX(hbox), clear, false, false, 0);
 
-			addLabel(grid, 0, 0, "Vendor ID", nullptr, false);
-			addEntry(grid, 0, 1, vid.c_str(), &m_vid, true);
-			addLabel(grid, 1, 0, "Product ID", nullptr, false);
-			addEntry(grid, 1, 1, pid.c_str(), &m_pid, true);
-			addLabel(grid, 2, 0, "Default product", nullptr, false);
-			addEntry(grid, 2, 1, m_configuration.product.c_str(), &m_product, true);
-			addLabel(grid, 3, 0, "Default manufacturer", nullptr, false);
-			addEntry(grid, 3, 1, m_configuration.manufacturer.c_str(), &m_manufacturer, true);
+			vbox = gtk_box_new(GTK_ORIENTATION_VERTICAL, 5);
+			setMargins(vbox);
+			gtk_notebook_append_page(GTK_NOTEBOOK(m_notebook), vbox, gtk_label_new("Dashboard"));
+			gtk_box_pack_start(GTK_BOX(vbox), createDashboard(), true, true, 0);
 
 			hbox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
 			gtk_box_pack_start(GTK_BOX(vbox), hbox, false, true, 0);
-			gtk_widget_set_halign(hbox, GTK_ALIGN_END);
-
-			apply = gtk_button_new_with_label("Apply");
-			g_signal_connect(apply, "clicked", G_CALLBACK(onConfigurationApply), this);
-			gtk_box_pack_start(GTK_BOX(hbox), apply, false, false, 0);
+			m_dashboard_status = gtk_label_new("");
+			gtk_label_set_xalign(GTK_LABEL(m_dashboard_status), 0.0f);
+			gtk_box_pack_start(GTK_BOX(hbox), m_dashboard_status, true, true, 0);
+			gtk_box_pack_start(GTK_BOX(hbox), gtk_label_new("Budget"), false, false, 0);
+			m_dashboard_budget = gtk_spin_button_new_with_range(1, 1000, 1);
+			gtk_spin_button_set_value(GTK_SPIN_BUTTON(m_dashboard_budget), m_poll_scheduler.getBudget());
+			g_signal_connect(m_dashboard_budget, "value-changed", G_CALLBACK(onDashboardBudgetChanged), this);
+			gtk_box_pack_start(GTK_BOX(hbox), m_dashboard_budget, false, false, 0);
+			gtk_box_pack_start(GTK_BOX(hbox), gtk_label_new("reads/s"), false, false, 0);
+			updateDashboardStatus();
 
 			gtk_box_pack_start(GTK_BOX(vbox_main), m_notebook, true, true, 0);
 			g_signal_connect(G_OBJECT(m_notebook), "switch-page", G_CALLBACK(onPageSwitch), this);
 
+			hbox = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+			setMargins(hbox);
+			m_spinner = gtk_spinner_new();
+			gtk_box_pack_start(GTK_BOX(hbox), m_spinner, false, false, 0);
+			m_status = gtk_label_new("");
+			gtk_label_set_xalign(GTK_LABEL(m_status), 0.0f);
+			gtk_box_pack_start(GTK_BOX(hbox), m_status, true, true, 0);
+			gtk_box_pack_start(GTK_BOX(vbox_main), hbox, false, false, 0);
+
+			m_worker.start();
+			m_apply_workers.start(apply_threads);
 			m_usb_event_thread = thread(&Impl::waitForUsbEvents, this);
 			showDevices();
 			gtk_widget_show_all(vbox_main);
@@ -696,31 +1469,44 @@ namespace gui
 			gtk_main();
 			return 0;
 		}
+		// Device list and its search entry are shared by the Properties and Description pages.
+		void moveDeviceList(GtkWidget *holder)
+		{
+			GtkWidget *parent = gtk_widget_get_parent(m_device_list_box);
+			if (parent == holder)
+				return;
+			g_object_ref(m_device_list_box);
+			gtk_container_remove(GTK_CONTAINER(parent), m_device_list_box);
+			gtk_box_pack_start(GTK_BOX(holder), m_device_list_box, true, true, 0);
+			g_object_unref(m_device_list_box);
+		}
 		void pageSwitch(int page)
 		{
 			switch (page){
 				case 0:
-					if (gtk_widget_get_parent(m_device_list) != m_device_scrolled_widget){
-						g_object_ref(m_device_list);
-						gtk_container_remove(GTK_CONTAINER(m_description_scrolled_widget), m_device_list);
-						gtk_container_add(GTK_CONTAINER(m_device_scrolled_widget), m_device_list);
-						g_object_unref(m_device_list);
-					}
+					moveDeviceList(m_device_holder);
 					break;
 				case 1:
-					if (gtk_widget_get_parent(m_device_list) != m_description_scrolled_widget){
-						g_object_ref(m_device_list);
-						gtk_container_remove(GTK_CONTAINER(m_device_scrolled_widget), m_device_list);
-						gtk_container_add(GTK_CONTAINER(m_description_scrolled_widget), m_device_list);
-						g_object_unref(m_device_list);
-					}
+					if (!m_description_page_built)
+						buildDescriptionPage();
+					moveDeviceList(m_description_device_holder);
+					break;
+				case 2:
+					if (!m_configuration_page_built)
+						buildConfigurationPage();
 					break;
 			}
+			setDashboardPolling(page == dashboard_page);
 		}
 		void applyConfiguration()
 		{
-			m_configuration.vid = toUint16(gtk_entry_get_text(GTK_ENTRY(m_vid)));
-			m_configuration.pid = toUint16(gtk_entry_get_text(GTK_ENTRY(m_pid)));
+			{
+				lock_guard<mutex> lock(m_before_close_mutex);
+				m_configuration.vid = toUint16(gtk_entry_get_text(GTK_ENTRY(m_vid)));
+				m_configuration.pid = toUint16(gtk_entry_get_text(GTK_ENTRY(m_pid)));
+				if (m_udev)
+					m_udev->setFilter(m_configuration.vid, m_configuration.pid);
+			}
 			m_configuration.manufacturer = gtk_entry_get_text(GTK_ENTRY(m_manufacturer));
 			m_configuration.product = gtk_entry_get_text(GTK_ENTRY(m_product));
 			showDevices();
@@ -731,20 +1517,75 @@ namespace gui
 			uint16_t pid = toUint16(gtk_entry_get_text(GTK_ENTRY(m_new_pid)));
 			string manufacturer = gtk_entry_get_text(GTK_ENTRY(m_new_manufacturer));
 			string product = gtk_entry_get_text(GTK_ENTRY(m_new_product));
-			mcp2200::Device device;
-			if (!device.open(m_current_device.c_str())){
-				return;
-			}
-			std::string old_manufacturer, old_product;
-			device.getManufacturer(old_manufacturer);
-			device.getProduct(old_product);
-			if (old_manufacturer != manufacturer)
-				device.setManufacturer(manufacturer.c_str());
-			if (old_product != product)
-				device.setProduct(product.c_str());
-			if (m_configuration.vid != vid || m_configuration.pid != pid)
-				device.setVendorProductIds(vid, pid);
-			showDevices();
+			string path = m_current_device;
+			bool set_ids = m_configuration.vid != vid || m_configuration.pid != pid;
+			runInBackground<shared_ptr<mcp2200::Reenumeration>>("Writing description...", "Could not write description", [this, path, vid, pid, manufacturer, product, set_ids](shared_ptr<mcp2200::Reenumeration> &reenumeration){
+				if (!useDevice(path)){
+					return false;
+				}
+				DeviceState state;
+				if (!readDevice(false, state)){
+					closeDevice();
+					return false;
+				}
+				auto &open_device = m_open_device;
+				bool result = true;
+				if (state.manufacturer != manufacturer)
+					result = open_device.device.setManufacturer(manufacturer.c_str()) && result;
+				if (state.product != product)
+					result = open_device.device.setProduct(product.c_str()) && result;
+				open_device.description_valid = false;
+				if (!set_ids){
+					if (!result)
+						closeDevice();
+					return result;
+				}
+				// Monitor has to be listening before new IDs are written, the device is reopened when it reappears.
+				string serial;
+				open_device.device.getSerial(serial);
+				reenumeration = make_shared<mcp2200::Reenumeration>();
+				reenumeration->start(serial, vid, pid);
+				result = open_device.device.setVendorProductIds(vid, pid) && result;
+				closeDevice();
+				return result;
+			}, [this, vid, pid](bool success, shared_ptr<mcp2200::Reenumeration> &reenumeration){
+				if (success && reenumeration)
+					waitForReconnect(reenumeration, vid, pid);
+			});
+		}
+		struct ReconnectResult
+		{
+			string path;
+			int64_t latency_us;
+		};
+		void waitForReconnect(shared_ptr<mcp2200::Reenumeration> reenumeration, uint16_t vid, uint16_t pid)
+		{
+			runInBackground<ReconnectResult>("Waiting for device to reconnect...", "Device did not reappear with new IDs", [this, reenumeration](ReconnectResult &result){
+				if (!reenumeration->wait(m_open_device.device, reconnect_timeout))
+					return false;
+				m_open_device.path = result.path = reenumeration->getPath();
+				m_dashboard_devices.erase(result.path);
+				result.latency_us = reenumeration->getLatency();
+				return true;
+			}, [this, vid, pid](bool success, ReconnectResult &result){
+				// Device list and hotplug filter follow the device to its new IDs, even if it did not come back in time.
+				{
+					lock_guard<mutex> lock(m_before_close_mutex);
+					m_configuration.vid = vid;
+					m_configuration.pid = pid;
+					if (m_udev)
+						m_udev->setFilter(vid, pid);
+				}
+				if (m_configuration_page_built){
+					gtk_entry_set_text(GTK_ENTRY(m_vid), toHexString(vid).c_str());
+					gtk_entry_set_text(GTK_ENTRY(m_pid), toHexString(pid).c_str());
+				}
+				if (success){
+					m_current_device = result.path;
+					g_debug("device reconnected as %s in %.1f ms", result.path.c_str(), result.latency_us / 1000.0);
+				}
+				showDevices(success ? result.path : string());
+			});
 		}
 		void loadDefaults()
 		{
@@ -762,8 +1603,8 @@ namespace gui
 		void waitForUsbEvents()
 		{
 #ifdef LINUX_BUILD
-			Udev udev;
-			udev.open();
+			mcp2200::Udev udev;
+			udev.open(true);
 			bool exit = false;
 			{
 				lock_guard<mutex> lock(m_before_close_mutex);
@@ -771,21 +1612,49 @@ namespace gui
 					exit = true;
 					udev.interruptRead();
 				};
+				udev.setFilter(m_configuration.vid, m_configuration.pid);
+				m_udev = &udev;
 			}
+			// Serial index used by command line program is kept up to date while the program is running.
+			mcp2200::SerialIndex index;
+			index.open();
 			while (!exit){
-				udev.read([this](const char *, const char *, const char *){
-					g_idle_add((GSourceFunc)&Impl::onUsbEvent, this);
+				bool read = udev.read([this, &index](const mcp2200::UdevEvent &event){
+					if (event.action == mcp2200::UdevEvent::Action::add)
+						index.update(event.vendor_id, event.product_id, event.serial, event.path);
+					else
+						index.remove(event.path);
+					// One device plug in produces events from both monitors, so events arriving within a short window are applied together.
+					if (m_usb_events.push(event.path, event))
+						g_timeout_add(usb_event_window, (GSourceFunc)&Impl::onUsbEvents, this);
 				});
+				if (!read){
+					g_warning("could not read device events, device list is no longer updated automatically");
+					break;
+				}
 			}
 			{
 				lock_guard<mutex> lock(m_before_close_mutex);
 				m_before_close = []{};
+				m_udev = nullptr;
 			}
 #endif
 		}
-		static gboolean onUsbEvent(Impl *app)
+		void applyUsbEvents()
 		{
-			app->showDevices();
+			for (auto &event: m_usb_events.take()){
+				applyUsbEvent(event);
+			}
+			auto statistics = m_usb_events.getStatistics();
+			g_debug("usb events: %llu, merged: %llu, refreshes: %llu, refreshes saved: %llu",
+				static_cast<unsigned long long>(statistics.events),
+				static_cast<unsigned long long>(statistics.merged),
+				static_cast<unsigned long long>(statistics.batches),
+				static_cast<unsigned long long>(statistics.getSavedRefreshes()));
+		}
+		static gboolean onUsbEvents(Impl *app)
+		{
+			app->applyUsbEvents();
 			return false;
 		}
 		static void onCursorChanged(GtkTreeView *, Impl *)
@@ -799,7 +1668,7 @@ namespace gui
 			gchar *path = nullptr;
 			gtk_tree_model_get(model, &iter, enum_value(DeviceColumn::path), &path, -1);
 			if (path){
-				app->openDevice(path);
+				app->openDevice(path, false);
 				g_free(path);
 			}
 		}
@@ -835,6 +1704,66 @@ namespace gui
 		{
 			app->pageSwitch(page_num);
 		}
+		static void onDeviceSearchChanged(GtkWidget *widget, Impl *app)
+		{
+			app->setDeviceFilter(gtk_entry_get_text(GTK_ENTRY(widget)));
+		}
+		static void onLiveToggled(GtkWidget *widget, Impl *app)
+		{
+			bool live = gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(widget));
+			gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(app->m_timeline_live), live);
+			app->setLive(live);
+		}
+		static void onTimelineLiveToggled(GtkWidget *widget, Impl *app)
+		{
+			gtk_toggle_button_set_active(GTK_TOGGLE_BUTTON(app->m_live), gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(widget)));
+		}
+		static void onOpenCapture(GtkWidget *, Impl *app)
+		{
+			app->openCapture();
+		}
+		static void onTimelineShowAll(GtkWidget *, Impl *app)
+		{
+			app->m_timeline.showAll();
+		}
+		static void onTimelineClear(GtkWidget *, Impl *app)
+		{
+			app->m_timeline.clear();
+			app->m_timeline_device.clear();
+		}
+		static void onLiveIntervalChanged(GtkWidget *, Impl *app)
+		{
+			if (gtk_toggle_button_get_active(GTK_TOGGLE_BUTTON(app->m_live)))
+				app->setLive(true);
+		}
+		static gboolean onLiveTimer(Impl *app)
+		{
+			app->pollGpioValues();
+			return true;
+		}
+		static gboolean onWindowState(GtkWidget *, GdkEventWindowState *event, Impl *app)
+		{
+			app->m_iconified = (event->new_window_state & GDK_WINDOW_STATE_ICONIFIED) != 0;
+			return false;
+		}
+		static gboolean onDashboardTimer(Impl *app)
+		{
+			app->pollDashboard();
+			return true;
+		}
+		static void onDashboardBudgetChanged(GtkWidget *widget, Impl *app)
+		{
+			app->m_poll_scheduler.setBudget(gtk_spin_button_get_value(GTK_SPIN_BUTTON(widget)));
+			app->updateDashboardStatus();
+			if (app->m_dashboard_timer)
+				app->setDashboardPolling(true);
+		}
+		static gboolean onFirstDraw(GtkWidget *widget, cairo_t *, Impl *app)
+		{
+			g_debug("first frame %.1f ms after start", (g_get_monotonic_time() - app->m_start_time) / 1000.0);
+			g_signal_handler_disconnect(widget, app->m_first_draw_handler);
+			return false;
+		}
 		static void onLoadDefaults(GtkWidget *, Impl *app)
 		{
 			app->loadDefaults();
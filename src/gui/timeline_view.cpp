@@ -0,0 +1,322 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "timeline_view.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+using namespace std;
+namespace gui
+{
+	const static int label_width = 56;
+	const static int axis_height = 20;
+	const static double default_range = 10000000;
+	TimelineView::TimelineView():
+		m_widget(nullptr),
+		m_begin(0),
+		m_end(default_range),
+		m_drag_x(0),
+		m_drag_begin(0),
+		m_follow(true),
+		m_dragging(false)
+	{
+	}
+	GtkWidget *TimelineView::create()
+	{
+		m_widget = gtk_drawing_area_new();
+		gtk_widget_set_size_request(m_widget, 200, 8 * 20 + axis_height);
+		gtk_widget_add_events(m_widget, GDK_BUTTON_PRESS_MASK | GDK_BUTTON_RELEASE_MASK | GDK_BUTTON1_MOTION_MASK | GDK_SCROLL_MASK | GDK_SMOOTH_SCROLL_MASK);
+		g_signal_connect(G_OBJECT(m_widget), "draw", G_CALLBACK(onDraw), this);
+		g_signal_connect(G_OBJECT(m_widget), "scroll-event", G_CALLBACK(onScroll), this);
+		g_signal_connect(G_OBJECT(m_widget), "button-press-event", G_CALLBACK(onButtonPress), this);
+		g_signal_connect(G_OBJECT(m_widget), "button-release-event", G_CALLBACK(onButtonRelease), this);
+		g_signal_connect(G_OBJECT(m_widget), "motion-notify-event", G_CALLBACK(onMotion), this);
+		return m_widget;
+	}
+	GtkWidget *TimelineView::getWidget()
+	{
+		return m_widget;
+	}
+	const mcp2200::SamplePyramid &TimelineView::getSamples() const
+	{
+		return m_samples;
+	}
+	void TimelineView::append(uint64_t time_us, uint8_t value)
+	{
+		uint64_t end = m_samples.empty() ? time_us : min<uint64_t>(m_samples.getEnd(), time_us);
+		m_samples.append(time_us, value);
+		invalidateFrom(end);
+	}
+	void TimelineView::extend(uint64_t time_us)
+	{
+		uint64_t end = m_samples.getEnd();
+		m_samples.extend(time_us);
+		if (m_samples.getEnd() != end)
+			invalidateFrom(end);
+	}
+	bool TimelineView::load(const string &filename)
+	{
+		ifstream file(filename, ios::binary);
+		if (!file.is_open())
+			return false;
+		vector<uint8_t> data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+		if (file.bad())
+			return false;
+		m_samples.clear();
+		m_samples.appendRecords(data.data(), data.size());
+		showAll();
+		m_follow = false;
+		return !m_samples.empty();
+	}
+	void TimelineView::clear()
+	{
+		m_samples.clear();
+		showAll();
+	}
+	void TimelineView::showAll()
+	{
+		if (m_samples.empty()){
+			m_begin = 0;
+			m_end = default_range;
+		}else{
+			m_begin = m_samples.getBegin();
+			m_end = max<double>(m_samples.getEnd(), m_begin + getColumns());
+		}
+		m_follow = true;
+		if (m_widget)
+			gtk_widget_queue_draw(m_widget);
+	}
+	int TimelineView::getColumns()
+	{
+		if (!m_widget)
+			return 1;
+		return max(1, gtk_widget_get_allocated_width(m_widget) - label_width);
+	}
+	double TimelineView::toX(double time_us)
+	{
+		return label_width + (time_us - m_begin) * getColumns() / (m_end - m_begin);
+	}
+	void TimelineView::invalidateFrom(uint64_t time_us)
+	{
+		if (!m_widget)
+			return;
+		if (m_follow && time_us > m_end){
+			double range = m_end - m_begin;
+			m_end = time_us + range / 10;
+			m_begin = m_end - range;
+			gtk_widget_queue_draw(m_widget);
+			return;
+		}
+		if (time_us > m_end)
+			return;
+		// New samples only change columns from their own time onwards, everything to the left stays as drawn.
+		int x = max(label_width, static_cast<int>(floor(toX(time_us))) - 1);
+		int width = gtk_widget_get_allocated_width(m_widget);
+		int height = gtk_widget_get_allocated_height(m_widget);
+		if (x < width)
+			gtk_widget_queue_draw_area(m_widget, x, 0, width - x, height - axis_height);
+	}
+	void TimelineView::zoom(double x, double factor)
+	{
+		int columns = getColumns();
+		double column = min<double>(max<double>(x - label_width, 0), columns);
+		double range = m_end - m_begin;
+		double time = m_begin + range * column / columns;
+		// At most one microsecond per column, samples have no finer resolution.
+		range = min(max(range * factor, static_cast<double>(columns)), 1e13);
+		m_begin = time - range * column / columns;
+		m_end = m_begin + range;
+		m_follow = false;
+		gtk_widget_queue_draw(m_widget);
+	}
+	void TimelineView::pan(double begin_us)
+	{
+		double range = m_end - m_begin;
+		m_begin = begin_us;
+		m_end = begin_us + range;
+		m_follow = false;
+		gtk_widget_queue_draw(m_widget);
+	}
+	void TimelineView::draw(cairo_t *cr)
+	{
+		int width = gtk_widget_get_allocated_width(m_widget);
+		int height = gtk_widget_get_allocated_height(m_widget);
+		GtkStyleContext *context = gtk_widget_get_style_context(m_widget);
+		gtk_render_background(context, cr, 0, 0, width, height);
+		GdkRGBA color;
+		gtk_style_context_get_color(context, gtk_widget_get_state_flags(m_widget), &color);
+		gdk_cairo_set_source_rgba(cr, &color);
+		cairo_set_line_width(cr, 1);
+		cairo_set_font_size(cr, 11);
+		double row_height = (height - axis_height) / 8.0;
+		for (int pin = 0; pin < 8; pin++){
+			char label[6] = {"GPIO0"};
+			label[4] = '0' + pin;
+			cairo_move_to(cr, 4, row_height * (pin + 0.5) + 4);
+			cairo_show_text(cr, label);
+		}
+		drawAxis(cr, height);
+		// Only columns inside the clip area are rendered, appended samples usually invalidate just the right edge.
+		GdkRectangle clip;
+		if (!gdk_cairo_get_clip_rectangle(cr, &clip)){
+			clip.x = 0;
+			clip.width = width;
+		}
+		int columns = getColumns();
+		int first = max(0, clip.x - label_width);
+		int last = min(columns, clip.x + clip.width - label_width + 1);
+		if (first >= last)
+			return;
+		double step = (m_end - m_begin) / columns;
+		m_samples.render(m_begin + step * first, m_begin + step * last, last - first, m_spans);
+		int count = last - first;
+		for (int pin = 0; pin < 8; pin++){
+			uint8_t mask = 1 << pin;
+			double high = floor(row_height * pin + 4) + 0.5;
+			double low = floor(row_height * (pin + 1) - 4) + 0.5;
+			auto state = [this, mask](int column){
+				auto &span = m_spans[column];
+				if (!span.valid)
+					return -1;
+				if (span.getTransitions() & mask)
+					return 2;
+				return (span.all & mask) ? 1 : 0;
+			};
+			// Runs of columns with a constant level become one line, columns containing transitions become filled blocks.
+			int previous = -1;
+			for (int column = 0; column < count;){
+				int current = state(column);
+				int end = column + 1;
+				while (end < count && state(end) == current)
+					end++;
+				double x0 = label_width + first + column, x1 = label_width + first + end;
+				if (current == 0 || current == 1){
+					double y = current ? high : low;
+					if (previous == 0 || previous == 1)
+						cairo_move_to(cr, x0, previous ? high : low);
+					else
+						cairo_move_to(cr, x0, y);
+					cairo_line_to(cr, x0, y);
+					cairo_line_to(cr, x1, y);
+				}
+				previous = current;
+				column = end;
+			}
+			cairo_stroke(cr);
+			for (int column = 0; column < count; column++){
+				if (state(column) == 2)
+					cairo_rectangle(cr, label_width + first + column, high, 1, low - high);
+			}
+			cairo_fill(cr);
+		}
+	}
+	void TimelineView::drawAxis(cairo_t *cr, int height)
+	{
+		int columns = getColumns();
+		double range = m_end - m_begin;
+		// Tick step of 1, 2 or 5 times a power of ten, leaving about 100 pixels between labels.
+		double raw_step = range * 100 / columns;
+		double magnitude = pow(10, floor(log10(raw_step)));
+		double step = magnitude * (raw_step / magnitude <= 2 ? 2 : raw_step / magnitude <= 5 ? 5 : 10);
+		int decimals = max(0, static_cast<int>(-floor(log10(step / 1000000))));
+		double y = height - axis_height + 0.5;
+		cairo_move_to(cr, label_width, y);
+		cairo_line_to(cr, label_width + columns, y);
+		for (double time = ceil(m_begin / step) * step; time <= m_end; time += step){
+			double x = floor(toX(time)) + 0.5;
+			cairo_move_to(cr, x, y);
+			cairo_line_to(cr, x, y + 4);
+			char label[32];
+			snprintf(label, sizeof(label), "%.*f s", decimals, time / 1000000);
+			cairo_move_to(cr, x + 2, height - 4);
+			cairo_show_text(cr, label);
+		}
+		cairo_stroke(cr);
+	}
+	gboolean TimelineView::onDraw(GtkWidget *, cairo_t *cr, TimelineView *view)
+	{
+		view->draw(cr);
+		return false;
+	}
+	gboolean TimelineView::onScroll(GtkWidget *, GdkEventScroll *event, TimelineView *view)
+	{
+		double range = view->m_end - view->m_begin;
+		switch (event->direction){
+			case GDK_SCROLL_UP:
+				if (event->state & GDK_SHIFT_MASK)
+					view->pan(view->m_begin - range / 10);
+				else
+					view->zoom(event->x, 1 / 1.25);
+				break;
+			case GDK_SCROLL_DOWN:
+				if (event->state & GDK_SHIFT_MASK)
+					view->pan(view->m_begin + range / 10);
+				else
+					view->zoom(event->x, 1.25);
+				break;
+			case GDK_SCROLL_LEFT:
+				view->pan(view->m_begin - range / 10);
+				break;
+			case GDK_SCROLL_RIGHT:
+				view->pan(view->m_begin + range / 10);
+				break;
+			case GDK_SCROLL_SMOOTH:
+				if (event->delta_x != 0)
+					view->pan(view->m_begin + range * event->delta_x / 10);
+				if (event->delta_y != 0)
+					view->zoom(event->x, pow(1.25, event->delta_y));
+				break;
+		}
+		return true;
+	}
+	gboolean TimelineView::onButtonPress(GtkWidget *, GdkEventButton *event, TimelineView *view)
+	{
+		if (event->button != 1)
+			return false;
+		if (event->type == GDK_2BUTTON_PRESS){
+			view->showAll();
+			return true;
+		}
+		view->m_dragging = true;
+		view->m_drag_x = event->x;
+		view->m_drag_begin = view->m_begin;
+		return true;
+	}
+	gboolean TimelineView::onButtonRelease(GtkWidget *, GdkEventButton *event, TimelineView *view)
+	{
+		if (event->button == 1)
+			view->m_dragging = false;
+		return false;
+	}
+	gboolean TimelineView::onMotion(GtkWidget *, GdkEventMotion *event, TimelineView *view)
+	{
+		if (!view->m_dragging)
+			return false;
+		double range = view->m_end - view->m_begin;
+		view->pan(view->m_drag_begin - (event->x - view->m_drag_x) * range / view->getColumns());
+		return true;
+	}
+}
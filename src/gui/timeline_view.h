@@ -0,0 +1,65 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_TIMELINE_VIEW_H_
+#define HEADER_TIMELINE_VIEW_H_
+#include "sample_pyramid.h"
+#include <gtk/gtk.h>
+#include <string>
+#include <vector>
+namespace gui
+{
+	// Logic analyzer style view of GPIO samples, each pin is drawn as a separate trace.
+	struct TimelineView
+	{
+		TimelineView();
+		GtkWidget *create();
+		GtkWidget *getWidget();
+		void append(uint64_t time_us, uint8_t value);
+		void extend(uint64_t time_us);
+		bool load(const std::string &filename);
+		void clear();
+		void showAll();
+		const mcp2200::SamplePyramid &getSamples() const;
+		private:
+		GtkWidget *m_widget;
+		mcp2200::SamplePyramid m_samples;
+		std::vector<mcp2200::SamplePyramid::Span> m_spans;
+		double m_begin, m_end, m_drag_x, m_drag_begin;
+		bool m_follow, m_dragging;
+		int getColumns();
+		double toX(double time_us);
+		void invalidateFrom(uint64_t time_us);
+		void zoom(double x, double factor);
+		void pan(double begin_us);
+		void draw(cairo_t *cr);
+		void drawAxis(cairo_t *cr, int height);
+		static gboolean onDraw(GtkWidget *widget, cairo_t *cr, TimelineView *view);
+		static gboolean onScroll(GtkWidget *widget, GdkEventScroll *event, TimelineView *view);
+		static gboolean onButtonPress(GtkWidget *widget, GdkEventButton *event, TimelineView *view);
+		static gboolean onButtonRelease(GtkWidget *widget, GdkEventButton *event, TimelineView *view);
+		static gboolean onMotion(GtkWidget *widget, GdkEventMotion *event, TimelineView *view);
+	};
+}
+#endif /* HEADER_TIMELINE_VIEW_H_ */
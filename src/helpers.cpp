@@ -33,6 +33,14 @@ namespace command_line
 	{
 		return stream << (value.value ? "on" : "off");
 	};
+	void appendHex(std::string &output, const uint8_t *data, size_t size)
+	{
+		const static char digits[] = "0123456789abcdef";
+		for (size_t i = 0; i < size; i++){
+			output += digits[data[i] >> 4];
+			output += digits[data[i] & 0x0f];
+		}
+	}
 #ifdef WIN32
 	std::string ucsToUtf8(const std::wstring &in)
 	{
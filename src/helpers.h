@@ -26,6 +26,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define HEADER_HELPERS_H_
 #include <iostream>
 #include <iomanip>
+#include <string>
+#include <stdint.h>
 #include <boost/program_options/options_description.hpp>
 namespace command_line
 {
@@ -107,6 +109,7 @@ namespace command_line
 		}
 	};
 	std::ostream& operator<<(std::ostream& stream, const Boolean &value);
+	void appendHex(std::string &output, const uint8_t *data, size_t size);
 	template <typename T>
 	struct HexOption
 	{
@@ -24,13 +24,30 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "list_command.h"
 #include "mcp2200.h"
+#include "udev.h"
+#include "sysfs_enumerator.h"
+#include "serial_index.h"
+#include "helpers.h"
 #include <iostream>
+#include <iomanip>
+#include <csignal>
+#include <chrono>
 namespace po = boost::program_options;
 using namespace std;
 namespace command_line
 {
+#ifdef HAVE_LIBUDEV
+	static volatile sig_atomic_t interrupted = 0;
+	static void onInterrupt(int)
+	{
+		interrupted = 1;
+	}
+#endif
 	ListCommand::ListCommand():
-		Command("list", "list devices")
+		Command("list", "list devices"),
+		m_follow(false),
+		m_sysfs(false),
+		m_benchmark(0)
 	{
 	}
 	ListCommand::~ListCommand()
@@ -39,6 +56,11 @@ namespace command_line
 	void ListCommand::addOptions(po::options_description &options, po::options_description &hidden_options)
 	{
 		m_vendor_product.addOptions(options, hidden_options);
+		options.add_options()
+			("follow", po::value<bool>(&m_follow)->default_value(false)->zero_tokens(), "after listing, print devices as they are connected or disconnected until interrupted (Linux only)")
+			("sysfs", po::value<bool>(&m_sysfs)->default_value(false)->zero_tokens(), "read device information from sysfs instead of HIDAPI (Linux only)")
+			("benchmark", po::value<size_t>(&m_benchmark)->default_value(0), "compare enumeration time of HIDAPI and sysfs over given number of runs")
+		;
 	}
 	bool ListCommand::checkOptions(po::variables_map &variable_map)
 	{
@@ -46,17 +68,107 @@ namespace command_line
 	}
 	bool ListCommand::run()
 	{
+		if (m_benchmark > 0)
+			return benchmark();
+		if (m_follow)
+			return follow();
+		return list();
+	}
+	bool ListCommand::find(vector<mcp2200::DeviceInformation> &devices)
+	{
+		if (m_sysfs){
+#ifdef LINUX_BUILD
+			return mcp2200::SysfsEnumerator().find(m_vendor_product.getVendorId(), m_vendor_product.getProductId(), devices);
+#else
+			cerr << "sysfs enumeration is only available on Linux\n";
+			return false;
+#endif
+		}
 		mcp2200::Device d;
 		d.find(m_vendor_product.getVendorId(), m_vendor_product.getProductId());
-		for (size_t i = 0; i < d.getCount(); i++){
+		devices.clear();
+		for (size_t i = 0; i < d.getCount(); i++)
+			devices.push_back(d[i]);
+		return true;
+	}
+	bool ListCommand::list()
+	{
+		vector<mcp2200::DeviceInformation> devices;
+		if (!find(devices)) return false;
+#ifdef LINUX_BUILD
+		mcp2200::SerialIndex index;
+		if (index.open())
+			index.replace(m_vendor_product.getVendorId(), m_vendor_product.getProductId(), devices);
+#endif
+		for (size_t i = 0; i < devices.size(); i++){
 			cout
 				<< setw(3) << i + 1 << ","
-				<< " \"" << d[i].manufacturer << "\","
-				<< " \"" << d[i].product << "\","
-				<< " \"" << d[i].serial << "\","
-				<< " \"" << d[i].path << "\""
+				<< " \"" << devices[i].manufacturer << "\","
+				<< " \"" << devices[i].product << "\","
+				<< " \"" << devices[i].serial << "\","
+				<< " \"" << devices[i].path << "\""
 				<< "\n";
 		}
-		return d.getCount() > 0;
+		return !devices.empty();
+	}
+	bool ListCommand::benchmark()
+	{
+		auto measure = [this](const char *name, bool sysfs){
+			m_sysfs = sysfs;
+			vector<mcp2200::DeviceInformation> devices;
+			auto start = chrono::steady_clock::now();
+			for (size_t i = 0; i < m_benchmark; i++)
+				find(devices);
+			double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+			ostream_state_saver state(cout);
+			cout << name << ": " << devices.size() << " devices, " << fixed << setprecision(3) << seconds * 1000 / m_benchmark << " ms per enumeration\n";
+		};
+		measure("hidapi", false);
+#ifdef LINUX_BUILD
+		measure("sysfs", true);
+#endif
+		return true;
+	}
+	bool ListCommand::follow()
+	{
+#ifdef HAVE_LIBUDEV
+		// Monitor is started before enumeration, so devices connected in between are not missed.
+		mcp2200::Udev udev;
+		if (!udev.open()){
+			cerr << "Could not start device monitor\n";
+			return false;
+		}
+		udev.setFilter(m_vendor_product.getVendorId(), m_vendor_product.getProductId());
+		list();
+		cout << flush;
+		mcp2200::SerialIndex index;
+		index.open();
+		interrupted = 0;
+		auto previous_handler = signal(SIGINT, onInterrupt);
+		bool result = true;
+		while (!interrupted){
+			result = udev.read([&index](const mcp2200::UdevEvent &event){
+				if (event.action == mcp2200::UdevEvent::Action::add)
+					index.update(event.vendor_id, event.product_id, event.serial, event.path);
+				else
+					index.remove(event.path);
+				cout
+					<< (event.action == mcp2200::UdevEvent::Action::add ? "add" : "remove") << ","
+					<< " " << hex << setfill('0') << setw(4) << event.vendor_id << ":" << setw(4) << event.product_id << dec << setfill(' ') << ","
+					<< " \"" << event.serial << "\","
+					<< " \"" << event.path << "\""
+					<< endl;
+			});
+			if (!result){
+				cerr << "Could not read device events\n";
+				break;
+			}
+		}
+		signal(SIGINT, previous_handler);
+		return result;
+#else
+		cerr << "Following device changes requires libudev\n";
+		return false;
+#endif
 	}
 }
@@ -26,8 +26,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define HEADER_LIST_COMMAND_H_
 #include "command.h"
 #include "vendor_product.h"
+#include "mcp2200.h"
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/variables_map.hpp>
+#include <vector>
 namespace command_line
 {
 	struct ListCommand: public Command
@@ -38,7 +40,14 @@ namespace command_line
 		virtual bool checkOptions(boost::program_options::variables_map &variable_map);
 		virtual bool run();
 		private:
+		bool find(std::vector<mcp2200::DeviceInformation> &devices);
+		bool list();
+		bool follow();
+		bool benchmark();
 		VendorProduct m_vendor_product;
+		bool m_follow;
+		bool m_sysfs;
+		size_t m_benchmark;
 	};
 }
 #endif /* HEADER_LIST_COMMAND_H_ */
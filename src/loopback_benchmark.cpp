@@ -0,0 +1,191 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef LINUX_BUILD
+#include "loopback_benchmark.h"
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <termios.h>
+using namespace std;
+namespace mcp2200
+{
+	using clock = chrono::steady_clock;
+	static double percentile(const vector<double> &sorted, double fraction)
+	{
+		if (sorted.empty()) return 0;
+		size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+		return sorted[min(index, sorted.size() - 1)];
+	}
+	static int remainingTimeout(clock::time_point deadline)
+	{
+		auto remaining = chrono::duration_cast<chrono::milliseconds>(deadline - clock::now()).count();
+		return remaining > 0 ? static_cast<int>(remaining) : 0;
+	}
+	LoopbackResult::LoopbackResult():
+		bytes_sent(0),
+		bytes_received(0),
+		errors(0),
+		throughput(0),
+		duration(0),
+		latency_p50(0),
+		latency_p90(0),
+		latency_p99(0),
+		latency_max(0),
+		latency_samples(0),
+		latency_timeouts(0)
+	{
+	}
+	double LoopbackResult::getErrorRate() const
+	{
+		return bytes_sent > 0 ? static_cast<double>(errors) / bytes_sent : 0;
+	}
+	LoopbackBenchmark::LoopbackBenchmark():
+		m_latency_samples(100),
+		m_throughput_bytes(4096),
+		m_timeout(1000)
+	{
+	}
+	LoopbackBenchmark &LoopbackBenchmark::setLatencySamples(size_t samples)
+	{
+		m_latency_samples = samples;
+		return *this;
+	}
+	LoopbackBenchmark &LoopbackBenchmark::setThroughputBytes(size_t bytes)
+	{
+		m_throughput_bytes = bytes;
+		return *this;
+	}
+	LoopbackBenchmark &LoopbackBenchmark::setTimeout(int timeout)
+	{
+		m_timeout = timeout;
+		return *this;
+	}
+	uint8_t LoopbackBenchmark::getPatternByte(uint64_t index)
+	{
+		// 251 is prime, so the pattern does not line up with power of two buffer sizes.
+		return static_cast<uint8_t>(index % 251);
+	}
+	bool LoopbackBenchmark::measureLatency(int write_fd, int read_fd, LoopbackResult &result)
+	{
+		vector<double> latencies;
+		latencies.reserve(m_latency_samples);
+		for (size_t i = 0; i < m_latency_samples; i++){
+			uint8_t sent = getPatternByte(i), received;
+			auto start = clock::now(), deadline = start + chrono::milliseconds(m_timeout);
+			if (write(write_fd, &sent, 1) != 1) return false;
+			bool done = false;
+			while (!done){
+				pollfd descriptor = {read_fd, POLLIN, 0};
+				int ready = poll(&descriptor, 1, remainingTimeout(deadline));
+				if (ready < 0){
+					if (errno == EINTR) continue;
+					return false;
+				}
+				if (ready == 0){
+					result.latency_timeouts++;
+					break;
+				}
+				ssize_t count = read(read_fd, &received, 1);
+				if (count < 0 && errno != EAGAIN && errno != EINTR) return false;
+				if (count == 1 && received == sent){
+					latencies.push_back(chrono::duration<double, micro>(clock::now() - start).count());
+					done = true;
+				}
+			}
+		}
+		sort(latencies.begin(), latencies.end());
+		result.latency_samples = latencies.size();
+		result.latency_p50 = percentile(latencies, 0.50);
+		result.latency_p90 = percentile(latencies, 0.90);
+		result.latency_p99 = percentile(latencies, 0.99);
+		result.latency_max = latencies.empty() ? 0 : latencies.back();
+		return true;
+	}
+	bool LoopbackBenchmark::measureThroughput(int write_fd, int read_fd, LoopbackResult &result)
+	{
+		vector<uint8_t> output(m_throughput_bytes), input(4096);
+		for (size_t i = 0; i < output.size(); i++){
+			output[i] = getPatternByte(i);
+		}
+		size_t sent = 0, received = 0;
+		auto start = clock::now(), last_activity = start, finish = start;
+		while (received < output.size()){
+			pollfd descriptors[2] = {{read_fd, POLLIN, 0}, {write_fd, static_cast<short>(sent < output.size() ? POLLOUT : 0), 0}};
+			int ready = poll(descriptors, 2, remainingTimeout(last_activity + chrono::milliseconds(m_timeout)));
+			if (ready < 0){
+				if (errno == EINTR) continue;
+				return false;
+			}
+			if (ready == 0) break;
+			if (descriptors[1].revents & POLLOUT){
+				ssize_t count = write(write_fd, output.data() + sent, output.size() - sent);
+				if (count < 0 && errno != EAGAIN && errno != EINTR) return false;
+				if (count > 0){
+					sent += count;
+					last_activity = clock::now();
+				}
+			}
+			if (descriptors[0].revents & POLLIN){
+				ssize_t count = read(read_fd, input.data(), input.size());
+				if (count < 0 && errno != EAGAIN && errno != EINTR) return false;
+				for (ssize_t i = 0; i < count && received < output.size(); i++, received++){
+					if (input[i] != output[received])
+						result.errors++;
+				}
+				if (count > 0)
+					last_activity = finish = clock::now();
+			}
+		}
+		result.bytes_sent = sent;
+		result.bytes_received = received;
+		result.errors += output.size() - received;
+		result.duration = chrono::duration<double>(finish - start).count();
+		result.throughput = result.duration > 0 ? received / result.duration : 0;
+		return true;
+	}
+	bool LoopbackBenchmark::run(int fd, LoopbackResult &result)
+	{
+		return run(fd, fd, result);
+	}
+	bool LoopbackBenchmark::run(int write_fd, int read_fd, LoopbackResult &result)
+	{
+		result = LoopbackResult();
+		int write_flags = fcntl(write_fd, F_GETFL), read_flags = fcntl(read_fd, F_GETFL);
+		if (write_flags < 0 || read_flags < 0) return false;
+		if (fcntl(write_fd, F_SETFL, write_flags | O_NONBLOCK) < 0 || fcntl(read_fd, F_SETFL, read_flags | O_NONBLOCK) < 0) return false;
+		tcflush(read_fd, TCIFLUSH);
+		bool success = measureLatency(write_fd, read_fd, result);
+		tcflush(read_fd, TCIFLUSH);
+		success = success && measureThroughput(write_fd, read_fd, result);
+		fcntl(write_fd, F_SETFL, write_flags);
+		fcntl(read_fd, F_SETFL, read_flags);
+		return success;
+	}
+}
+#endif
@@ -0,0 +1,56 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_LOOPBACK_BENCHMARK_H_
+#define HEADER_LOOPBACK_BENCHMARK_H_
+#include <stdint.h>
+#include <cstddef>
+namespace mcp2200
+{
+	struct LoopbackResult
+	{
+		uint64_t bytes_sent, bytes_received, errors;
+		double throughput, duration;
+		double latency_p50, latency_p90, latency_p99, latency_max;
+		size_t latency_samples, latency_timeouts;
+		LoopbackResult();
+		double getErrorRate() const;
+	};
+	struct LoopbackBenchmark
+	{
+		LoopbackBenchmark();
+		LoopbackBenchmark &setLatencySamples(size_t samples);
+		LoopbackBenchmark &setThroughputBytes(size_t bytes);
+		LoopbackBenchmark &setTimeout(int timeout);
+		bool run(int fd, LoopbackResult &result);
+		bool run(int write_fd, int read_fd, LoopbackResult &result);
+		static uint8_t getPatternByte(uint64_t index);
+		private:
+		size_t m_latency_samples, m_throughput_bytes;
+		int m_timeout;
+		bool measureLatency(int write_fd, int read_fd, LoopbackResult &result);
+		bool measureThroughput(int write_fd, int read_fd, LoopbackResult &result);
+	};
+}
+#endif /* HEADER_LOOPBACK_BENCHMARK_H_ */
@@ -26,6 +26,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <hidapi/hidapi.h>
 #include <codecvt>
 #include <locale>
+#include <cstring>
 #include <iostream>
 #include <boost/endian/conversion.hpp>
 using namespace std;
@@ -145,17 +146,24 @@ namespace mcp2200
 	{
 		return reinterpret_cast<uint8_t *>(this);
 	}
+	uint16_t toBaudRateDivisor(int baud_rate)
+	{
+		return static_cast<uint16_t>(baud_rate_clock / baud_rate - 1);
+	}
+	int fromBaudRateDivisor(uint16_t divisor)
+	{
+		return baud_rate_clock / (divisor + 1);
+	}
 	Command &Command::setBaudRate(int baud_rate)
 	{
 		using namespace boost::endian;
-		int divisor = 12000000 / baud_rate - 1;
-		configure.baud_rate = native_to_big(divisor);
+		configure.baud_rate = native_to_big(toBaudRateDivisor(baud_rate));
 		return *this;
 	}
 	int Command::getBaudRate() const
 	{
 		using namespace boost::endian;
-		return 12000000 / (big_to_native(read_all_response.baud_rate) + 1);
+		return fromBaudRateDivisor(big_to_native(read_all_response.baud_rate));
 	}
 	Command &Command::setIoDirections(uint8_t io_directions)
 	{
@@ -392,8 +400,107 @@ namespace mcp2200
 		toUtf8(trimToLength(serial_wide), serial);
 		return true;
 	}
+	DeviceInformation DeviceSnapshot::Entry::toInformation() const
+	{
+		DeviceInformation information;
+		information.path = path;
+		information.serial = serial;
+		information.manufacturer = manufacturer;
+		information.product = product;
+		information.release_number = release_number;
+		return information;
+	}
+	DeviceSnapshot::DeviceSnapshot()
+	{
+	}
+	bool DeviceSnapshot::find(uint16_t vendor_id, uint16_t product_id)
+	{
+		clear();
+		hid_device_info *devices = hid_enumerate(vendor_id, product_id);
+		if (!devices) return false;
+		for (hid_device_info *i = devices; i != nullptr; i = i->next)
+			add(i->path, i->serial_number, i->manufacturer_string, i->product_string, i->release_number);
+		hid_free_enumeration(devices);
+		return true;
+	}
+	void DeviceSnapshot::append(const char *value)
+	{
+		if (value)
+			m_buffer.insert(m_buffer.end(), value, value + strlen(value));
+	}
+	void DeviceSnapshot::append(const wchar_t *value)
+	{
+		// UTF-8 is written straight into the buffer, wchar_t holds UTF-16 on Windows and UTF-32 elsewhere.
+		if (!value) return;
+		for (; *value; value++){
+			uint32_t code = static_cast<uint32_t>(*value);
+			if (sizeof(wchar_t) == 2 && code >= 0xd800 && code < 0xdc00 && value[1] >= 0xdc00 && value[1] < 0xe000){
+				code = 0x10000 + ((code - 0xd800) << 10) + (static_cast<uint32_t>(value[1]) - 0xdc00);
+				value++;
+			}
+			if (code < 0x80){
+				m_buffer.push_back(static_cast<char>(code));
+			}else if (code < 0x800){
+				m_buffer.push_back(static_cast<char>(0xc0 | (code >> 6)));
+				m_buffer.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+			}else if (code < 0x10000){
+				m_buffer.push_back(static_cast<char>(0xe0 | (code >> 12)));
+				m_buffer.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+				m_buffer.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+			}else{
+				m_buffer.push_back(static_cast<char>(0xf0 | (code >> 18)));
+				m_buffer.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3f)));
+				m_buffer.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3f)));
+				m_buffer.push_back(static_cast<char>(0x80 | (code & 0x3f)));
+			}
+		}
+	}
+	void DeviceSnapshot::add(const char *path, const wchar_t *serial, const wchar_t *manufacturer, const wchar_t *product, uint16_t release_number)
+	{
+		Record record;
+		record.release_number = release_number;
+		record.offsets[0] = static_cast<uint32_t>(m_buffer.size());
+		append(path);
+		record.offsets[1] = static_cast<uint32_t>(m_buffer.size());
+		append(serial);
+		record.offsets[2] = static_cast<uint32_t>(m_buffer.size());
+		append(manufacturer);
+		record.offsets[3] = static_cast<uint32_t>(m_buffer.size());
+		append(product);
+		record.offsets[4] = static_cast<uint32_t>(m_buffer.size());
+		m_records.push_back(record);
+	}
+	void DeviceSnapshot::clear()
+	{
+		m_buffer.clear();
+		m_records.clear();
+	}
+	size_t DeviceSnapshot::size() const
+	{
+		return m_records.size();
+	}
+	bool DeviceSnapshot::empty() const
+	{
+		return m_records.empty();
+	}
+	DeviceSnapshot::Entry DeviceSnapshot::get(size_t index) const
+	{
+		auto &record = m_records[index];
+		auto field = [this, &record](size_t i){
+			return string_view(m_buffer.data() + record.offsets[i], record.offsets[i + 1] - record.offsets[i]);
+		};
+		return Entry{field(0), field(1), field(2), field(3), record.release_number};
+	}
+	DeviceSnapshot::Entry DeviceSnapshot::operator[](size_t index) const
+	{
+		return get(index);
+	}
+	Transport::~Transport()
+	{
+	}
 	Device::Device():
 		m_handle(nullptr),
+		m_transport(nullptr),
 		m_timeout(-1)
 	{
 	}
@@ -401,16 +508,6 @@ namespace mcp2200
 	{
 		close();
 	}
-	bool Device::configure(std::function<void(Command &command)> actions)
-	{
-		Command command = {};
-		if (!readAll(command)) return false;
-		command
-			.setCommand(CommandType::configure)
-			;
-		actions(command);
-		return write(command);
-	}
 	bool Device::configure(uint8_t io_directions, int baud_rate, LedMode rx_led_mode, LedMode tx_led_mode, bool flow_control, bool usb_configure, bool suspend, bool invert)
 	{
 		return configure([io_directions, baud_rate, rx_led_mode, tx_led_mode, flow_control, usb_configure, suspend, invert](Command &command){
@@ -428,42 +525,24 @@ namespace mcp2200
 	}
 	bool Device::find(uint16_t vendor_id, uint16_t product_id)
 	{
-		hid_device_info *devices = hid_enumerate(vendor_id, product_id);
-		if (!devices) return false;
-		size_t device_count = 0;
-		hid_device_info *i = devices;
-		while (i != nullptr){
-			device_count++;
-			i = i->next;
-		}
-		m_found.resize(device_count);
-		size_t device_i = 0;
-		i = devices;
-		while (i != nullptr){
-			string manufacturer_n, product_n, serial_n;
-			if (i->manufacturer_string != nullptr)
-				toUtf8(wstring(i->manufacturer_string), manufacturer_n);
-			if (i->product_string != nullptr)
-				toUtf8(wstring(i->product_string), product_n);
-			if (i->serial_number != nullptr)
-				toUtf8(wstring(i->serial_number), serial_n);
-			m_found[device_i++] = DeviceInformation(i->path, serial_n.c_str(), manufacturer_n.c_str(), product_n.c_str(), i->release_number);
-			i = i->next;
-		}
-		hid_free_enumeration(devices);
-		return true;
+		return m_snapshot.find(vendor_id, product_id);
 	}
 	size_t Device::getCount() const
 	{
-		return m_found.size();
+		return m_snapshot.size();
+	}
+	DeviceInformation Device::get(size_t index) const
+	{
+		// Owning copy, use getSnapshot() to read device information without allocating.
+		return m_snapshot[index].toInformation();
 	}
-	const DeviceInformation &Device::get(size_t index) const
+	DeviceInformation Device::operator[](size_t index) const
 	{
-		return m_found[index];
+		return get(index);
 	}
-	const DeviceInformation &Device::operator[](size_t index) const
+	const DeviceSnapshot &Device::getSnapshot() const
 	{
-		return m_found[index];
+		return m_snapshot;
 	}
 	bool Device::open(uint16_t vendor_id, uint16_t product_id, const char *serial)
 	{
@@ -496,18 +575,27 @@ namespace mcp2200
 	{
 		return open(device_path.c_str());
 	}
+	bool Device::open(Transport &transport)
+	{
+		close();
+		m_transport = &transport;
+		return true;
+	}
 	void Device::close()
 	{
 		if (m_handle != nullptr)
 			hid_close(m_handle);
 		m_handle = nullptr;
+		m_transport = nullptr;
 	}
 	bool Device::isOpen()
 	{
-		return m_handle != nullptr;
+		return m_handle != nullptr || m_transport != nullptr;
 	}
 	bool Device::write(const Command &command)
 	{
+		if (m_transport) return m_transport->write(command);
+		if (!m_handle) return false;
 		if (hid_write(m_handle, command.getPointer(), command.length()) < 0) return false;
 		return true;
 	}
@@ -517,6 +605,8 @@ namespace mcp2200
 	}
 	bool Device::read(Command &response)
 	{
+		if (m_transport) return m_transport->read(response, m_timeout);
+		if (!m_handle) return false;
 		if (m_timeout != -1){
 			if (hid_read_timeout(m_handle, response.getPointer(), response.length(), m_timeout) < 0) return false;
 		}else{
@@ -524,28 +614,25 @@ namespace mcp2200
 		}
 		return true;
 	}
+	void Device::drainInput()
+	{
+		// hidraw queues every input report on every open handle, so reports caused by other handles to the same device are dropped
+		// here. Otherwise the response read below would be an older one.
+		if (!m_handle) return;
+		Command report;
+		for (int i = 0; i < max_drained_reports; i++){
+			if (hid_read_timeout(m_handle, report.getPointer(), report.length(), 0) <= 0) break;
+		}
+	}
 	bool Device::readAll(Command &response)
 	{
+		drainInput();
 		Command command = {};
 		command
 			.setCommand(CommandType::read_all)
 			;
 		return write(command) && read(response);
 	}
-	bool Device::writeAfterRead(std::function<bool(Command &command)> command_prepare)
-	{
-		Command response;
-		if (!readAll(response)){
-			return false;
-		}
-		Command command(response);
-		if (command_prepare){
-			if (!command_prepare(command)){
-				return false;
-			}
-		}
-		return write(command);
-	}
 	bool Device::setGpioValues(uint8_t values)
 	{
 		Command command = {};
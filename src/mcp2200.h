@@ -26,6 +26,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define HEADER_MCP2200_H_
 #include <stdint.h>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <functional>
 #include <array>
@@ -129,6 +130,7 @@ namespace mcp2200
 		};
 		Command();
 		Command(const Command &command);
+		Command &operator=(const Command &command) = default;
 		Command &setCommand(CommandType command_type);
 		int length() const;
 		const uint8_t *getPointer() const;
@@ -174,28 +176,71 @@ namespace mcp2200
 		std::string product;
 		uint16_t release_number;
 	};
+	const static int baud_rate_clock = 12000000;
+	uint16_t toBaudRateDivisor(int baud_rate);
+	int fromBaudRateDivisor(uint16_t divisor);
 	const static uint16_t defaultVendorId = 0x04d8;
 	const static uint16_t defaultProductId = 0x00df;
+	// Enumeration result keeping all strings in one buffer, so repeated searches reuse memory instead of allocating strings for each device.
+	struct DeviceSnapshot
+	{
+		struct Entry
+		{
+			std::string_view path, serial, manufacturer, product;
+			uint16_t release_number;
+			DeviceInformation toInformation() const;
+		};
+		DeviceSnapshot();
+		bool find(uint16_t vendor_id = defaultVendorId, uint16_t product_id = defaultProductId);
+		void add(const char *path, const wchar_t *serial, const wchar_t *manufacturer, const wchar_t *product, uint16_t release_number);
+		void clear();
+		size_t size() const;
+		bool empty() const;
+		Entry get(size_t index) const;
+		Entry operator[](size_t index) const;
+		private:
+		struct Record
+		{
+			uint32_t offsets[5];
+			uint16_t release_number;
+		};
+		std::vector<char> m_buffer;
+		std::vector<Record> m_records;
+		void append(const char *value);
+		void append(const wchar_t *value);
+	};
+	// Report level access to a device, used instead of hidapi when attached with Device::open(Transport &). Lets tests run device
+	// operations against an emulated device.
+	struct Transport
+	{
+		virtual ~Transport();
+		virtual bool write(const Command &command) = 0;
+		virtual bool read(Command &response, int timeout) = 0;
+	};
 	struct Device
 	{
 		Device();
 		~Device();
 		bool find(uint16_t vendor_id = defaultVendorId, uint16_t product_id = defaultProductId);
 		size_t getCount() const;
-		const DeviceInformation &get(size_t index) const;
-		const DeviceInformation &operator[](size_t index) const;
+		DeviceInformation get(size_t index) const;
+		DeviceInformation operator[](size_t index) const;
+		const DeviceSnapshot &getSnapshot() const;
 		bool open(uint16_t vendor_id = defaultVendorId, uint16_t product_id = defaultProductId, const char *serial = nullptr);
 		bool open(const DeviceInformation &device);
 		bool open(const char *device_path);
 		bool open(const std::string &device_path);
+		bool open(Transport &transport);
 		void close();
 		bool isOpen();
 		bool write(const Command &command);
 		bool read(Command &command);
 		bool readAll(Command &response);
-		bool writeAfterRead(std::function<bool(Command &command)> command_prepare);
+		template <typename Prepare>
+		bool writeAfterRead(Prepare &&command_prepare);
 		bool configure(uint8_t io_directions, int baud_rate, LedMode rx_led_mode, LedMode tx_led_mode, bool flow_control, bool usb_configure, bool suspend, bool invert);
-		bool configure(std::function<void(Command &)> actions);
+		template <typename Actions>
+		bool configure(Actions &&actions);
 		bool setGpioValues(uint8_t values);
 		bool setInvert(bool invert);
 		bool setSuspend(bool suspend);
@@ -212,9 +257,31 @@ namespace mcp2200
 		bool setString(ConfigurationType type, const char *value);
 		void setReadTimeout(int timeout);
 		private:
+		const static int max_drained_reports = 64;
 		hid_device *m_handle;
-		std::vector<DeviceInformation> m_found;
+		Transport *m_transport;
+		DeviceSnapshot m_snapshot;
 		int m_timeout;
+		void drainInput();
 	};
+	template <typename Prepare>
+	bool Device::writeAfterRead(Prepare &&command_prepare)
+	{
+		Command command;
+		if (!readAll(command)) return false;
+		if (!command_prepare(command)) return false;
+		return write(command);
+	}
+	template <typename Actions>
+	bool Device::configure(Actions &&actions)
+	{
+		Command command;
+		if (!readAll(command)) return false;
+		command
+			.setCommand(CommandType::configure)
+			;
+		actions(command);
+		return write(command);
+	}
 };
 #endif /* HEADER_MCP2200_H_ */
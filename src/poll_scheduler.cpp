@@ -0,0 +1,111 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "poll_scheduler.h"
+#include <algorithm>
+using namespace std;
+namespace mcp2200
+{
+	PollScheduler::PollScheduler(double transactions_per_second, uint64_t min_interval_us):
+		m_position(0),
+		m_interval(0),
+		m_min_interval(min_interval_us),
+		m_next_time(0),
+		m_transactions(0)
+	{
+		setBudget(transactions_per_second);
+	}
+	void PollScheduler::setBudget(double transactions_per_second)
+	{
+		m_interval = static_cast<uint64_t>(1000000 / max(transactions_per_second, 0.001));
+	}
+	double PollScheduler::getBudget() const
+	{
+		return 1000000.0 / m_interval;
+	}
+	void PollScheduler::setMinInterval(uint64_t min_interval_us)
+	{
+		m_min_interval = min_interval_us;
+	}
+	bool PollScheduler::add(const string &key)
+	{
+		for (auto &entry: m_entries){
+			if (entry.key == key)
+				return false;
+		}
+		m_entries.push_back(Entry{key, 0, false});
+		return true;
+	}
+	bool PollScheduler::remove(const string &key)
+	{
+		for (size_t i = 0; i < m_entries.size(); i++){
+			if (m_entries[i].key != key)
+				continue;
+			m_entries.erase(m_entries.begin() + i);
+			if (i < m_position)
+				m_position--;
+			return true;
+		}
+		return false;
+	}
+	void PollScheduler::clear()
+	{
+		m_entries.clear();
+		m_position = 0;
+	}
+	size_t PollScheduler::size() const
+	{
+		return m_entries.size();
+	}
+	bool PollScheduler::next(uint64_t now_us, string &key)
+	{
+		if (m_entries.empty() || now_us < m_next_time)
+			return false;
+		size_t count = m_entries.size();
+		for (size_t i = 0; i < count; i++){
+			auto &entry = m_entries[(m_position + i) % count];
+			if (entry.polled && now_us < entry.last_poll + m_min_interval)
+				continue;
+			key = entry.key;
+			entry.last_poll = now_us;
+			entry.polled = true;
+			m_position = (m_position + i + 1) % count;
+			// Late calls keep the average rate, but unused budget is not saved up for a burst after an idle period.
+			if (now_us > m_next_time + m_interval)
+				m_next_time = now_us;
+			m_next_time += m_interval;
+			m_transactions++;
+			return true;
+		}
+		return false;
+	}
+	uint64_t PollScheduler::getDeviceInterval() const
+	{
+		return max(m_min_interval, m_interval * m_entries.size());
+	}
+	uint64_t PollScheduler::getTransactions() const
+	{
+		return m_transactions;
+	}
+}
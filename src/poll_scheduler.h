@@ -0,0 +1,59 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_POLL_SCHEDULER_H_
+#define HEADER_POLL_SCHEDULER_H_
+#include <stdint.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+namespace mcp2200
+{
+	// Spreads polls of several devices over time, all devices together never get more than the configured number of transactions per second.
+	struct PollScheduler
+	{
+		PollScheduler(double transactions_per_second = 20, uint64_t min_interval_us = 0);
+		void setBudget(double transactions_per_second);
+		double getBudget() const;
+		void setMinInterval(uint64_t min_interval_us);
+		bool add(const std::string &key);
+		bool remove(const std::string &key);
+		void clear();
+		size_t size() const;
+		bool next(uint64_t now_us, std::string &key);
+		uint64_t getDeviceInterval() const;
+		uint64_t getTransactions() const;
+		private:
+		struct Entry
+		{
+			std::string key;
+			uint64_t last_poll;
+			bool polled;
+		};
+		std::vector<Entry> m_entries;
+		size_t m_position;
+		uint64_t m_interval, m_min_interval, m_next_time, m_transactions;
+	};
+}
+#endif /* HEADER_POLL_SCHEDULER_H_ */
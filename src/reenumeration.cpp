@@ -0,0 +1,146 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "reenumeration.h"
+#include "udev.h"
+#include <algorithm>
+#include <thread>
+using namespace std;
+namespace mcp2200
+{
+	const static int poll_interval_ms = 20;
+	const static int open_retry_ms = 5;
+	struct ReenumerationMonitor
+	{
+#ifdef HAVE_LIBUDEV
+		Udev udev;
+#endif
+		bool events = false;
+	};
+	Reenumeration::Reenumeration():
+		m_monitor(new ReenumerationMonitor()),
+		m_vendor_id(0),
+		m_product_id(0),
+		m_present_at_start(false),
+		m_latency(-1)
+	{
+	}
+	Reenumeration::~Reenumeration()
+	{
+	}
+	bool Reenumeration::start(const string &serial, uint16_t vendor_id, uint16_t product_id, bool wait_for_removal)
+	{
+		// Called before the identity is written, so the monitor is listening when the device comes back and latency includes the write.
+		m_start = chrono::steady_clock::now();
+		m_serial = serial;
+		m_vendor_id = vendor_id;
+		m_product_id = product_id;
+		m_path.clear();
+		m_latency = -1;
+		m_present_at_start = false;
+#ifdef HAVE_LIBUDEV
+		m_monitor->udev.close();
+		m_monitor->events = m_monitor->udev.open();
+		if (m_monitor->events){
+			m_monitor->udev.setFilter(vendor_id, product_id);
+			return true;
+		}
+#endif
+		// Without events a device which already matches has to disappear first when its identity is about to change, otherwise the handle about to go away would be opened.
+		// A device which was already lost may be listed before its node becomes accessible, so then it is opened as soon as possible instead.
+		if (wait_for_removal){
+			DeviceSnapshot devices;
+			string path;
+			m_present_at_start = findTarget(devices, path);
+		}
+		return true;
+	}
+	bool Reenumeration::isTarget(const string &serial, uint16_t vendor_id, uint16_t product_id) const
+	{
+		if (vendor_id != m_vendor_id || product_id != m_product_id) return false;
+		return m_serial.empty() || serial == m_serial;
+	}
+	bool Reenumeration::findTarget(DeviceSnapshot &devices, string &path) const
+	{
+		devices.find(m_vendor_id, m_product_id);
+		for (size_t i = 0; i < devices.size(); i++){
+			auto device = devices[i];
+			if (!isTarget(string(device.serial), m_vendor_id, m_product_id)) continue;
+			path = device.path;
+			return true;
+		}
+		return false;
+	}
+	bool Reenumeration::usesEvents() const
+	{
+		return m_monitor->events;
+	}
+	const string &Reenumeration::getPath() const
+	{
+		return m_path;
+	}
+	int64_t Reenumeration::getLatency() const
+	{
+		return m_latency;
+	}
+	bool Reenumeration::wait(Device &device, int timeout_ms)
+	{
+		auto deadline = chrono::steady_clock::now() + chrono::milliseconds(timeout_ms);
+		auto remaining = [deadline](){
+			return static_cast<int>(max<int64_t>(0, chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count()));
+		};
+		DeviceSnapshot devices;
+		string path;
+		while (path.empty()){
+			if (chrono::steady_clock::now() >= deadline) return false;
+#ifdef HAVE_LIBUDEV
+			if (m_monitor->events){
+				bool read = m_monitor->udev.read([this, &path](const UdevEvent &event){
+					if (event.action == UdevEvent::Action::add && isTarget(event.serial, event.vendor_id, event.product_id))
+						path = event.path;
+				}, remaining());
+				// Monitor failed, devices are enumerated for the rest of the wait.
+				if (!read)
+					m_monitor->events = false;
+				continue;
+			}
+#endif
+			if (findTarget(devices, path)){
+				if (!m_present_at_start) break;
+				path.clear();
+			}else{
+				m_present_at_start = false;
+			}
+			this_thread::sleep_for(chrono::milliseconds(min(poll_interval_ms, remaining())));
+		}
+		// Device node can appear shortly before it is accessible, so opening is retried until the deadline.
+		while (!device.open(path)){
+			if (chrono::steady_clock::now() >= deadline) return false;
+			this_thread::sleep_for(chrono::milliseconds(min(open_retry_ms, remaining())));
+		}
+		m_path = path;
+		m_latency = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - m_start).count();
+		return true;
+	}
+}
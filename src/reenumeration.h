@@ -0,0 +1,59 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_REENUMERATION_H_
+#define HEADER_REENUMERATION_H_
+#include "mcp2200.h"
+#include <stdint.h>
+#include <string>
+#include <memory>
+#include <chrono>
+namespace mcp2200
+{
+	struct ReenumerationMonitor;
+	// Waits for a device to appear again after its USB identity was changed and opens it as soon as it does.
+	// Hotplug events are used when libudev is available, otherwise devices are enumerated periodically.
+	struct Reenumeration
+	{
+		Reenumeration();
+		~Reenumeration();
+		bool start(const std::string &serial, uint16_t vendor_id, uint16_t product_id, bool wait_for_removal = true);
+		bool wait(Device &device, int timeout_ms);
+		bool isTarget(const std::string &serial, uint16_t vendor_id, uint16_t product_id) const;
+		bool usesEvents() const;
+		const std::string &getPath() const;
+		int64_t getLatency() const;
+		private:
+		std::unique_ptr<ReenumerationMonitor> m_monitor;
+		std::string m_serial, m_path;
+		uint16_t m_vendor_id, m_product_id;
+		bool m_present_at_start;
+		std::chrono::steady_clock::time_point m_start;
+		int64_t m_latency;
+		bool findTarget(DeviceSnapshot &devices, std::string &path) const;
+		Reenumeration(const Reenumeration &) = delete;
+		void operator=(const Reenumeration &) = delete;
+	};
+}
+#endif /* HEADER_REENUMERATION_H_ */
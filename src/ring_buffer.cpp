@@ -0,0 +1,115 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "ring_buffer.h"
+#include <algorithm>
+#include <cstring>
+#ifdef LINUX_BUILD
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+using namespace std;
+namespace mcp2200
+{
+	static size_t roundUpToPowerOfTwo(size_t value)
+	{
+		size_t result = 1;
+		while (result < value)
+			result <<= 1;
+		return result;
+	}
+	size_t RingBuffer::Segments::size() const
+	{
+		return first_size + second_size;
+	}
+	RingBuffer::Segments RingBuffer::Segments::slice(size_t offset, size_t size) const
+	{
+		if (offset >= first_size)
+			return Segments{second + (offset - first_size), second, size, 0};
+		size_t first_part = min(size, first_size - offset);
+		return Segments{first + offset, second, first_part, size - first_part};
+	}
+	RingBuffer::RingBuffer(size_t capacity):
+		m_data(roundUpToPowerOfTwo(capacity)),
+		m_mask(m_data.size() - 1),
+		m_head(0),
+		m_tail(0)
+	{
+	}
+	size_t RingBuffer::capacity() const
+	{
+		return m_data.size();
+	}
+	size_t RingBuffer::size() const
+	{
+		return m_head - m_tail;
+	}
+	size_t RingBuffer::space() const
+	{
+		return capacity() - size();
+	}
+	bool RingBuffer::empty() const
+	{
+		return m_head == m_tail;
+	}
+	size_t RingBuffer::write(const uint8_t *data, size_t size)
+	{
+		size = min(size, space());
+		size_t offset = m_head & m_mask;
+		size_t first = min(size, capacity() - offset);
+		memcpy(&m_data[offset], data, first);
+		memcpy(&m_data[0], data + first, size - first);
+		m_head += size;
+		return size;
+	}
+#ifdef LINUX_BUILD
+	ssize_t RingBuffer::readFrom(int fd)
+	{
+		// Both free segments are filled by one readv call, so wrapping around does not need an extra system call.
+		size_t free_space = space();
+		if (free_space == 0) return 0;
+		size_t offset = m_head & m_mask;
+		size_t first = min(free_space, capacity() - offset);
+		iovec vectors[2] = {{&m_data[offset], first}, {&m_data[0], free_space - first}};
+		ssize_t count = readv(fd, vectors, vectors[1].iov_len > 0 ? 2 : 1);
+		if (count > 0)
+			m_head += count;
+		return count;
+	}
+#endif
+	RingBuffer::Segments RingBuffer::peek() const
+	{
+		size_t offset = m_tail & m_mask;
+		size_t first = min(size(), capacity() - offset);
+		return Segments{&m_data[offset], &m_data[0], first, size() - first};
+	}
+	void RingBuffer::consume(size_t size)
+	{
+		m_tail += min(size, this->size());
+	}
+	void RingBuffer::clear()
+	{
+		m_head = m_tail = 0;
+	}
+}
@@ -0,0 +1,65 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_RING_BUFFER_H_
+#define HEADER_RING_BUFFER_H_
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#ifdef LINUX_BUILD
+#include <sys/types.h>
+#endif
+namespace mcp2200
+{
+	struct RingBuffer
+	{
+		struct Segments
+		{
+			const uint8_t *first, *second;
+			size_t first_size, second_size;
+			size_t size() const;
+			Segments slice(size_t offset, size_t size) const;
+			uint8_t operator[](size_t index) const
+			{
+				return index < first_size ? first[index] : second[index - first_size];
+			}
+		};
+		RingBuffer(size_t capacity);
+		size_t capacity() const;
+		size_t size() const;
+		size_t space() const;
+		bool empty() const;
+		size_t write(const uint8_t *data, size_t size);
+#ifdef LINUX_BUILD
+		ssize_t readFrom(int fd);
+#endif
+		Segments peek() const;
+		void consume(size_t size);
+		void clear();
+		private:
+		std::vector<uint8_t> m_data;
+		size_t m_mask, m_head, m_tail;
+	};
+}
+#endif /* HEADER_RING_BUFFER_H_ */
@@ -0,0 +1,165 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "sample_pyramid.h"
+#include <algorithm>
+#include <boost/endian/conversion.hpp>
+#include <cstring>
+using namespace std;
+namespace mcp2200
+{
+	uint8_t SamplePyramid::Span::getTransitions() const
+	{
+		return all ^ any;
+	}
+	SamplePyramid::SamplePyramid():
+		m_end(0)
+	{
+	}
+	void SamplePyramid::append(uint64_t time_us, uint8_t value)
+	{
+		if (!m_times.empty())
+			time_us = max(time_us, m_times.back());
+		m_times.push_back(time_us);
+		m_values.push_back(value);
+		m_end = max(m_end, time_us);
+		// Level L bucket b summarizes samples [b * 2^L, (b + 1) * 2^L), only the last bucket of each level changes.
+		size_t index = m_values.size() - 1;
+		for (size_t level = 1; level <= m_levels.size(); level++){
+			auto &buckets = m_levels[level - 1];
+			size_t bucket = index >> level;
+			if (bucket == buckets.size()){
+				buckets.push_back(Bucket{value, value});
+			}else{
+				buckets[bucket].all &= value;
+				buckets[bucket].any |= value;
+			}
+		}
+		size_t count = m_values.size();
+		if (count >= 2 && (count & (count - 1)) == 0){
+			Bucket first, second;
+			if (m_levels.empty()){
+				first = Bucket{m_values[0], m_values[0]};
+				second = Bucket{m_values[1], m_values[1]};
+			}else{
+				first = m_levels.back()[0];
+				second = m_levels.back()[1];
+			}
+			m_levels.emplace_back(1, Bucket{static_cast<uint8_t>(first.all & second.all), static_cast<uint8_t>(first.any | second.any)});
+		}
+	}
+	void SamplePyramid::extend(uint64_t time_us)
+	{
+		m_end = max(m_end, time_us);
+	}
+	size_t SamplePyramid::appendRecords(const uint8_t *data, size_t size)
+	{
+		size_t count = size / record_size;
+		for (size_t i = 0; i < count; i++){
+			uint64_t time_us;
+			memcpy(&time_us, data + i * record_size, sizeof(time_us));
+			append(boost::endian::little_to_native(time_us), data[i * record_size + 8]);
+		}
+		return count * record_size;
+	}
+	void SamplePyramid::clear()
+	{
+		m_times.clear();
+		m_values.clear();
+		m_levels.clear();
+		m_end = 0;
+	}
+	size_t SamplePyramid::size() const
+	{
+		return m_values.size();
+	}
+	bool SamplePyramid::empty() const
+	{
+		return m_values.empty();
+	}
+	uint64_t SamplePyramid::getBegin() const
+	{
+		return m_times.empty() ? 0 : m_times.front();
+	}
+	uint64_t SamplePyramid::getEnd() const
+	{
+		return m_end;
+	}
+	uint64_t SamplePyramid::getTime(size_t index) const
+	{
+		return m_times[index];
+	}
+	uint8_t SamplePyramid::getValue(size_t index) const
+	{
+		return m_values[index];
+	}
+	size_t SamplePyramid::getLevels() const
+	{
+		return m_levels.size();
+	}
+	SamplePyramid::Span SamplePyramid::query(size_t begin, size_t end) const
+	{
+		Span result{0xff, 0x00, false};
+		end = min(end, m_values.size());
+		while (begin < end){
+			size_t level = 0;
+			while (level < m_levels.size() && (begin & ((size_t(2) << level) - 1)) == 0 && begin + (size_t(2) << level) <= end)
+				level++;
+			if (level == 0){
+				result.all &= m_values[begin];
+				result.any |= m_values[begin];
+			}else{
+				auto &bucket = m_levels[level - 1][begin >> level];
+				result.all &= bucket.all;
+				result.any |= bucket.any;
+			}
+			result.valid = true;
+			begin += size_t(1) << level;
+		}
+		return result;
+	}
+	void SamplePyramid::render(double begin_us, double end_us, size_t columns, vector<Span> &spans) const
+	{
+		spans.assign(columns, Span{0, 0, false});
+		if (m_times.empty() || columns == 0 || end_us <= begin_us) return;
+		double step = (end_us - begin_us) / columns;
+		auto time_less = [](double time, uint64_t sample_time){ return time < sample_time; };
+		auto sample_less = [](uint64_t sample_time, double time){ return sample_time < time; };
+		// Index of the first sample after the column start, the sample before it holds the value at the column start.
+		size_t index = upper_bound(m_times.begin(), m_times.end(), begin_us, time_less) - m_times.begin();
+		for (size_t column = 0; column < columns; column++){
+			double column_begin = begin_us + step * column;
+			double column_end = column_begin + step;
+			size_t next = lower_bound(m_times.begin() + index, m_times.end(), column_end, sample_less) - m_times.begin();
+			Span span = query(index, next);
+			if (index > 0 && column_begin <= m_end){
+				span.all &= m_values[index - 1];
+				span.any |= m_values[index - 1];
+				span.valid = true;
+			}
+			spans[column] = span;
+			index = upper_bound(m_times.begin() + next, m_times.end(), column_end, time_less) - m_times.begin();
+		}
+	}
+}
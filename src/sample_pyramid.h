@@ -0,0 +1,67 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_SAMPLE_PYRAMID_H_
+#define HEADER_SAMPLE_PYRAMID_H_
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+namespace mcp2200
+{
+	// GPIO samples with a multi-resolution AND/OR summary, so any time range can be reduced to the values seen in it in logarithmic time.
+	struct SamplePyramid
+	{
+		struct Span
+		{
+			uint8_t all, any;
+			bool valid;
+			uint8_t getTransitions() const;
+		};
+		SamplePyramid();
+		void append(uint64_t time_us, uint8_t value);
+		void extend(uint64_t time_us);
+		size_t appendRecords(const uint8_t *data, size_t size);
+		void clear();
+		size_t size() const;
+		bool empty() const;
+		uint64_t getBegin() const;
+		uint64_t getEnd() const;
+		uint64_t getTime(size_t index) const;
+		uint8_t getValue(size_t index) const;
+		Span query(size_t begin, size_t end) const;
+		void render(double begin_us, double end_us, size_t columns, std::vector<Span> &spans) const;
+		size_t getLevels() const;
+		static constexpr size_t record_size = 9;
+		private:
+		struct Bucket
+		{
+			uint8_t all, any;
+		};
+		std::vector<uint64_t> m_times;
+		std::vector<uint8_t> m_values;
+		std::vector<std::vector<Bucket>> m_levels;
+		uint64_t m_end;
+	};
+}
+#endif /* HEADER_SAMPLE_PYRAMID_H_ */
@@ -0,0 +1,149 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "sample_writer.h"
+#include <iostream>
+#include <boost/program_options/errors.hpp>
+#include <boost/program_options/value_semantic.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/endian/conversion.hpp>
+using namespace std;
+namespace command_line
+{
+	void validate(boost::any &v, const std::vector<std::string> &values, SampleFormat *, int)
+	{
+		using namespace boost::program_options;
+		validators::check_first_occurrence(v);
+		auto value_string = validators::get_single_string(values);
+		boost::algorithm::to_lower(value_string);
+		SampleFormat format = SampleFormat::text;
+		if (value_string == "text")
+			format = SampleFormat::text;
+		else if (value_string == "csv")
+			format = SampleFormat::csv;
+		else if (value_string == "ndjson")
+			format = SampleFormat::ndjson;
+		else if (value_string == "binary")
+			format = SampleFormat::binary;
+		else
+			throw validation_error(validation_error::invalid_option_value);
+		v = boost::any(format);
+	}
+	ostream& operator<<(ostream& stream, const SampleFormat &format)
+	{
+		switch (format){
+			case SampleFormat::text:
+				stream << "text";
+				break;
+			case SampleFormat::csv:
+				stream << "csv";
+				break;
+			case SampleFormat::ndjson:
+				stream << "ndjson";
+				break;
+			case SampleFormat::binary:
+				stream << "binary";
+				break;
+		}
+		return stream;
+	}
+	SampleWriter::SampleWriter(SampleFormat format, size_t capacity):
+		m_format(format),
+		m_capacity(capacity),
+		m_header(format == SampleFormat::csv)
+	{
+		m_buffer.reserve(capacity + 64);
+	}
+	void SampleWriter::appendBits(uint8_t value, char separator)
+	{
+		for (int i = 0; i < 8; i++){
+			if (separator && i > 0)
+				m_buffer += separator;
+			m_buffer += ((value >> i) & 1) ? '1' : '0';
+		}
+	}
+	void SampleWriter::write(uint64_t time_us, uint8_t value)
+	{
+		char number[24];
+		switch (m_format){
+			case SampleFormat::text:
+				snprintf(number, sizeof(number), "%llu.%06llu ", static_cast<unsigned long long>(time_us / 1000000), static_cast<unsigned long long>(time_us % 1000000));
+				m_buffer += number;
+				appendBits(value, 0);
+				m_buffer += '\n';
+				break;
+			case SampleFormat::csv:
+				if (m_header){
+					m_buffer += "time_us,gpio0,gpio1,gpio2,gpio3,gpio4,gpio5,gpio6,gpio7\n";
+					m_header = false;
+				}
+				snprintf(number, sizeof(number), "%llu,", static_cast<unsigned long long>(time_us));
+				m_buffer += number;
+				appendBits(value, ',');
+				m_buffer += '\n';
+				break;
+			case SampleFormat::ndjson:
+				snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(time_us));
+				m_buffer += "{\"time_us\":";
+				m_buffer += number;
+				snprintf(number, sizeof(number), "%u", value);
+				m_buffer += ",\"gpio\":";
+				m_buffer += number;
+				m_buffer += ",\"bits\":\"";
+				appendBits(value, 0);
+				m_buffer += "\"}\n";
+				break;
+			case SampleFormat::binary:
+				{
+					uint64_t time_le = boost::endian::native_to_little(time_us);
+					m_buffer.append(reinterpret_cast<const char *>(&time_le), sizeof(time_le));
+					m_buffer += static_cast<char>(value);
+				}
+				break;
+		}
+	}
+	bool SampleWriter::isFull() const
+	{
+		return m_buffer.size() >= m_capacity;
+	}
+	bool SampleWriter::isEmpty() const
+	{
+		return m_buffer.empty();
+	}
+	const string &SampleWriter::getBuffer() const
+	{
+		return m_buffer;
+	}
+	void SampleWriter::clear()
+	{
+		m_buffer.clear();
+	}
+	bool SampleWriter::flush(FILE *file)
+	{
+		if (m_buffer.empty()) return true;
+		bool result = fwrite(m_buffer.data(), 1, m_buffer.size(), file) == m_buffer.size();
+		m_buffer.clear();
+		return fflush(file) == 0 && result;
+	}
+}
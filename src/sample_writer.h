@@ -0,0 +1,61 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_SAMPLE_WRITER_H_
+#define HEADER_SAMPLE_WRITER_H_
+#include <stdint.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <boost/any.hpp>
+namespace command_line
+{
+	enum class SampleFormat: uint8_t
+	{
+		text,
+		csv,
+		ndjson,
+		binary,
+	};
+	void validate(boost::any &v, const std::vector<std::string> &values, SampleFormat *, int);
+	std::ostream& operator<<(std::ostream& stream, const SampleFormat &format);
+	struct SampleWriter
+	{
+		static constexpr size_t binary_record_size = 9;
+		SampleWriter(SampleFormat format, size_t capacity = 64 * 1024);
+		void write(uint64_t time_us, uint8_t value);
+		bool isFull() const;
+		bool isEmpty() const;
+		const std::string &getBuffer() const;
+		void clear();
+		bool flush(std::FILE *file);
+		private:
+		SampleFormat m_format;
+		size_t m_capacity;
+		bool m_header;
+		std::string m_buffer;
+		void appendBits(uint8_t value, char separator);
+	};
+}
+#endif /* HEADER_SAMPLE_WRITER_H_ */
@@ -0,0 +1,219 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef LINUX_BUILD
+#include "serial_index.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+using namespace std;
+namespace mcp2200
+{
+	const static char index_magic[8] = {'M', 'C', 'P', 'I', 'D', 'X', '1', '\0'};
+	const static size_t index_entries = 64;
+	struct SerialIndexEntry
+	{
+		uint16_t vendor_id, product_id;
+		uint8_t used;
+		char serial[63];
+		char path[64];
+	};
+	struct SerialIndexFile
+	{
+		char magic[8];
+		uint32_t next;
+		uint32_t reserved;
+		SerialIndexEntry entries[index_entries];
+	};
+	template <size_t N>
+	static bool fits(const char (&)[N], const string &value)
+	{
+		return value.size() < N && value.find('\0') == string::npos;
+	}
+	template <size_t N>
+	static bool equals(const char (&field)[N], const string &value)
+	{
+		return value.size() < N && memcmp(field, value.c_str(), value.size() + 1) == 0;
+	}
+	template <size_t N>
+	static void copy(char (&field)[N], const string &value)
+	{
+		memset(field, 0, N);
+		memcpy(field, value.c_str(), value.size());
+	}
+	// Advisory lock shared by all processes using the same index file.
+	struct FileLock
+	{
+		FileLock(int fd, bool exclusive):
+			m_fd(fd)
+		{
+			while (flock(m_fd, exclusive ? LOCK_EX : LOCK_SH) != 0 && errno == EINTR);
+		}
+		~FileLock()
+		{
+			flock(m_fd, LOCK_UN);
+		}
+		private:
+		int m_fd;
+	};
+	SerialIndex::SerialIndex():
+		m_fd(-1),
+		m_file(nullptr)
+	{
+	}
+	SerialIndex::~SerialIndex()
+	{
+		close();
+	}
+	string SerialIndex::getDefaultFilename()
+	{
+		// Device paths change after reboot, so the index is kept in runtime directory which is cleared on boot.
+		const char *runtime_dir = getenv("XDG_RUNTIME_DIR");
+		if (runtime_dir != nullptr && *runtime_dir != '\0')
+			return string(runtime_dir) + "/mcp2200ctl-serial-index";
+		return "/tmp/mcp2200ctl-serial-index-" + to_string(getuid());
+	}
+	bool SerialIndex::open(const string &filename)
+	{
+		close();
+		// Fallback location is in a shared directory, so links and files created by other users are refused.
+		m_fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_CLOEXEC | O_NOFOLLOW, 0600);
+		if (m_fd < 0) return false;
+		FileLock lock(m_fd, true);
+		struct stat file_stat;
+		if (fstat(m_fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) || file_stat.st_uid != getuid() || (file_stat.st_mode & 0777) != 0600 ||
+			(static_cast<size_t>(file_stat.st_size) != sizeof(SerialIndexFile) && ftruncate(m_fd, sizeof(SerialIndexFile)) != 0)){
+			::close(m_fd);
+			m_fd = -1;
+			return false;
+		}
+		void *data = mmap(nullptr, sizeof(SerialIndexFile), PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+		if (data == MAP_FAILED){
+			::close(m_fd);
+			m_fd = -1;
+			return false;
+		}
+		m_file = static_cast<SerialIndexFile *>(data);
+		if (memcmp(m_file->magic, index_magic, sizeof(index_magic)) != 0){
+			memset(m_file, 0, sizeof(SerialIndexFile));
+			memcpy(m_file->magic, index_magic, sizeof(index_magic));
+		}
+		return true;
+	}
+	void SerialIndex::close()
+	{
+		if (m_file != nullptr)
+			munmap(m_file, sizeof(SerialIndexFile));
+		m_file = nullptr;
+		if (m_fd >= 0)
+			::close(m_fd);
+		m_fd = -1;
+	}
+	bool SerialIndex::isOpen() const
+	{
+		return m_file != nullptr;
+	}
+	bool SerialIndex::lookup(uint16_t vendor_id, uint16_t product_id, const string &serial, string &path) const
+	{
+		if (!m_file || serial.empty()) return false;
+		FileLock lock(m_fd, false);
+		for (auto &entry: m_file->entries){
+			if (!entry.used || entry.vendor_id != vendor_id || entry.product_id != product_id || !equals(entry.serial, serial)) continue;
+			path.assign(entry.path, strnlen(entry.path, sizeof(entry.path)));
+			return true;
+		}
+		return false;
+	}
+	void SerialIndex::insert(uint16_t vendor_id, uint16_t product_id, const string &serial, const string &path)
+	{
+		// A path belongs to one device and a serial to one path, so older entries matching either are dropped.
+		SerialIndexEntry *free_entry = nullptr;
+		for (auto &entry: m_file->entries){
+			if (entry.used && (equals(entry.path, path) || (entry.vendor_id == vendor_id && entry.product_id == product_id && equals(entry.serial, serial))))
+				entry.used = 0;
+			if (!entry.used && !free_entry)
+				free_entry = &entry;
+		}
+		if (!free_entry){
+			free_entry = &m_file->entries[m_file->next % index_entries];
+			m_file->next = (m_file->next + 1) % index_entries;
+		}
+		free_entry->vendor_id = vendor_id;
+		free_entry->product_id = product_id;
+		copy(free_entry->serial, serial);
+		copy(free_entry->path, path);
+		free_entry->used = 1;
+	}
+	bool SerialIndex::update(uint16_t vendor_id, uint16_t product_id, const string &serial, const string &path)
+	{
+		if (!m_file || serial.empty() || !fits(m_file->entries[0].serial, serial) || !fits(m_file->entries[0].path, path)) return false;
+		FileLock lock(m_fd, true);
+		insert(vendor_id, product_id, serial, path);
+		return true;
+	}
+	bool SerialIndex::remove(const string &path)
+	{
+		if (!m_file) return false;
+		FileLock lock(m_fd, true);
+		bool removed = false;
+		for (auto &entry: m_file->entries){
+			if (entry.used && equals(entry.path, path)){
+				entry.used = 0;
+				removed = true;
+			}
+		}
+		return removed;
+	}
+	bool SerialIndex::replace(uint16_t vendor_id, uint16_t product_id, const vector<DeviceInformation> &devices)
+	{
+		if (!m_file) return false;
+		FileLock lock(m_fd, true);
+		for (auto &entry: m_file->entries){
+			if (entry.used && entry.vendor_id == vendor_id && entry.product_id == product_id)
+				entry.used = 0;
+		}
+		for (auto &device: devices){
+			if (device.serial.empty() || !fits(m_file->entries[0].serial, device.serial) || !fits(m_file->entries[0].path, device.path)) continue;
+			insert(vendor_id, product_id, device.serial, device.path);
+		}
+		return true;
+	}
+	size_t SerialIndex::size() const
+	{
+		if (!m_file) return 0;
+		FileLock lock(m_fd, false);
+		size_t count = 0;
+		for (auto &entry: m_file->entries){
+			if (entry.used)
+				count++;
+		}
+		return count;
+	}
+}
+#endif
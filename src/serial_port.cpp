@@ -0,0 +1,239 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef LINUX_BUILD
+#include "serial_port.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+using namespace std;
+namespace fs = std::filesystem;
+namespace mcp2200
+{
+	struct BaudRateSpeed
+	{
+		int baud_rate;
+		speed_t speed;
+	};
+	const static BaudRateSpeed standard_speeds[] = {
+		{300, B300}, {600, B600}, {1200, B1200}, {2400, B2400}, {4800, B4800}, {9600, B9600},
+		{19200, B19200}, {38400, B38400}, {57600, B57600}, {115200, B115200}, {230400, B230400},
+		{460800, B460800}, {500000, B500000}, {576000, B576000}, {921600, B921600}, {1000000, B1000000},
+	};
+	SerialPort::SerialPort():
+		m_fd(-1)
+	{
+	}
+	SerialPort::~SerialPort()
+	{
+		close();
+	}
+	bool SerialPort::open(const string &path)
+	{
+		close();
+		m_fd = ::open(path.c_str(), O_RDWR | O_NOCTTY | O_CLOEXEC);
+		if (m_fd < 0) return false;
+		m_path = path;
+		return true;
+	}
+	void SerialPort::close()
+	{
+		if (m_fd >= 0)
+			::close(m_fd);
+		m_fd = -1;
+	}
+	bool SerialPort::isOpen() const
+	{
+		return m_fd >= 0;
+	}
+	int SerialPort::getFd() const
+	{
+		return m_fd;
+	}
+	const string &SerialPort::getPath() const
+	{
+		return m_path;
+	}
+	int SerialPort::toStandardBaudRate(int baud_rate)
+	{
+		// MCP2200 divisor rates (12 MHz / (divisor + 1)) are matched to the closest standard rate within 3%.
+		int best = 0;
+		for (auto &standard: standard_speeds){
+			if (abs(standard.baud_rate - baud_rate) * 100 > standard.baud_rate * 3) continue;
+			if (best == 0 || abs(standard.baud_rate - baud_rate) < abs(best - baud_rate))
+				best = standard.baud_rate;
+		}
+		return best;
+	}
+	vector<int> SerialPort::getStandardBaudRates()
+	{
+		vector<int> result;
+		for (auto &standard: standard_speeds){
+			result.push_back(standard.baud_rate);
+		}
+		return result;
+	}
+	bool SerialPort::configure(int baud_rate, bool flow_control)
+	{
+		int standard_baud_rate = toStandardBaudRate(baud_rate);
+		speed_t speed = B0;
+		for (auto &standard: standard_speeds){
+			if (standard.baud_rate == standard_baud_rate)
+				speed = standard.speed;
+		}
+		if (speed == B0) return false;
+		termios options;
+		if (tcgetattr(m_fd, &options) < 0) return false;
+		cfmakeraw(&options);
+		options.c_cflag |= CLOCAL | CREAD;
+		if (flow_control)
+			options.c_cflag |= CRTSCTS;
+		else
+			options.c_cflag &= ~CRTSCTS;
+		options.c_cc[VMIN] = 1;
+		options.c_cc[VTIME] = 0;
+		if (cfsetispeed(&options, speed) < 0 || cfsetospeed(&options, speed) < 0) return false;
+		if (tcsetattr(m_fd, TCSANOW, &options) < 0) return false;
+		tcflush(m_fd, TCIOFLUSH);
+		return true;
+	}
+	bool SerialPort::setNonBlocking(bool non_blocking)
+	{
+		int flags = fcntl(m_fd, F_GETFL);
+		if (flags < 0) return false;
+		flags = non_blocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+		return fcntl(m_fd, F_SETFL, flags) == 0;
+	}
+	bool SerialPort::drain()
+	{
+		return tcdrain(m_fd) == 0;
+	}
+	bool SerialPort::findPath(const string &hidraw_path, string &tty_path, const string &sysfs_root)
+	{
+		// hidrawN/device points to the HID device, its parent is the USB interface and the interface parent is the USB device.
+		// The CDC data interface of the same USB device has a tty/ttyACMn directory.
+		error_code ec;
+		auto name = fs::path(hidraw_path).filename();
+		auto hid_device = fs::canonical(fs::path(sysfs_root) / "class" / "hidraw" / name / "device", ec);
+		if (ec) return false;
+		auto usb_device = hid_device.parent_path().parent_path();
+		auto prefix = usb_device.filename().string() + ":";
+		for (auto &interface: fs::directory_iterator(usb_device, ec)){
+			if (interface.path().filename().string().compare(0, prefix.size(), prefix) != 0) continue;
+			for (auto &tty: fs::directory_iterator(interface.path() / "tty", ec)){
+				tty_path = (fs::path("/dev") / tty.path().filename()).string();
+				return true;
+			}
+		}
+		return false;
+	}
+	StreamPump::StreamPump(int in_fd, int out_fd, size_t buffer_size):
+		m_in_fd(in_fd),
+		m_out_fd(out_fd),
+		m_splice(false),
+		m_finished(false),
+		m_blocked(false),
+		m_bytes(0),
+		m_pending_offset(0),
+		m_pending_size(0)
+	{
+		struct stat in_stat, out_stat;
+		bool in_pipe = fstat(in_fd, &in_stat) == 0 && S_ISFIFO(in_stat.st_mode);
+		bool out_pipe = fstat(out_fd, &out_stat) == 0 && S_ISFIFO(out_stat.st_mode);
+		m_splice = in_pipe || out_pipe;
+		m_buffer.resize(buffer_size);
+	}
+	bool StreamPump::writePending()
+	{
+		while (m_pending_size > 0){
+			ssize_t wrote = ::write(m_out_fd, m_buffer.data() + m_pending_offset, m_pending_size);
+			if (wrote < 0){
+				if (errno == EINTR) continue;
+				return errno == EAGAIN;
+			}
+			m_pending_offset += wrote;
+			m_pending_size -= wrote;
+			m_bytes += wrote;
+		}
+		return true;
+	}
+	ssize_t StreamPump::transfer()
+	{
+		// Output may be non-blocking, data it does not accept stays buffered until the next call.
+		m_blocked = false;
+		uint64_t bytes = m_bytes;
+		if (m_pending_size > 0){
+			if (!writePending()) return -1;
+			return static_cast<ssize_t>(m_bytes - bytes);
+		}
+		if (m_finished) return 0;
+		ssize_t count;
+		if (m_splice){
+			count = splice(m_in_fd, nullptr, m_out_fd, nullptr, m_buffer.size(), SPLICE_F_MOVE);
+			if (count < 0 && (errno == EINVAL || errno == ENOSYS)){
+				// Not every file type supports splice, use buffered copy for the rest of the stream.
+				m_splice = false;
+				return transfer();
+			}
+			if (count > 0)
+				m_bytes += count;
+		}else{
+			count = ::read(m_in_fd, m_buffer.data(), m_buffer.size());
+			if (count > 0){
+				m_pending_offset = 0;
+				m_pending_size = count;
+				if (!writePending()) return -1;
+			}
+		}
+		if (count < 0){
+			// Input is polled before transfer, so with splice this means the output is full.
+			if (errno == EAGAIN)
+				m_blocked = m_splice;
+			if (errno == EINTR || errno == EAGAIN) return 0;
+			return -1;
+		}
+		if (count == 0){
+			m_finished = true;
+			return 0;
+		}
+		return static_cast<ssize_t>(m_bytes - bytes);
+	}
+	bool StreamPump::isFinished() const
+	{
+		return m_finished;
+	}
+	bool StreamPump::isBlocked() const
+	{
+		return m_blocked || m_pending_size > 0;
+	}
+	uint64_t StreamPump::getBytes() const
+	{
+		return m_bytes;
+	}
+}
+#endif
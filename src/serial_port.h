@@ -0,0 +1,72 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_SERIAL_PORT_H_
+#define HEADER_SERIAL_PORT_H_
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <sys/types.h>
+namespace mcp2200
+{
+	struct SerialPort
+	{
+		SerialPort();
+		~SerialPort();
+		bool open(const std::string &path);
+		void close();
+		bool isOpen() const;
+		bool configure(int baud_rate, bool flow_control);
+		bool setNonBlocking(bool non_blocking);
+		bool drain();
+		int getFd() const;
+		const std::string &getPath() const;
+		static int toStandardBaudRate(int baud_rate);
+		static std::vector<int> getStandardBaudRates();
+		static bool findPath(const std::string &hidraw_path, std::string &tty_path, const std::string &sysfs_root = "/sys");
+		private:
+		int m_fd;
+		std::string m_path;
+		SerialPort(SerialPort const &) = delete;
+		void operator=(SerialPort const &x) = delete;
+	};
+	struct StreamPump
+	{
+		StreamPump(int in_fd, int out_fd, size_t buffer_size = 256 * 1024);
+		ssize_t transfer();
+		bool isFinished() const;
+		bool isBlocked() const;
+		uint64_t getBytes() const;
+		private:
+		int m_in_fd, m_out_fd;
+		bool m_splice, m_finished, m_blocked;
+		uint64_t m_bytes;
+		std::vector<char> m_buffer;
+		size_t m_pending_offset, m_pending_size;
+		bool writePending();
+		StreamPump(StreamPump const &) = delete;
+		void operator=(StreamPump const &x) = delete;
+	};
+}
+#endif /* HEADER_SERIAL_PORT_H_ */
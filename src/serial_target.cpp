@@ -0,0 +1,108 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef LINUX_BUILD
+#include "serial_target.h"
+#include <iostream>
+namespace po = boost::program_options;
+using namespace std;
+namespace command_line
+{
+	SerialTarget::SerialTarget():
+		m_baud_rate(0),
+		m_port_baud_rate(0),
+		m_port_set(false),
+		m_baud_rate_set(false)
+	{
+	}
+	void SerialTarget::addOptions(po::options_description &options, po::options_description &)
+	{
+		options.add_options()
+			("port", po::value<string>(&m_port), "serial port path (found from the HID device by default)")
+			("baud", po::value<int>(&m_baud_rate), "serial port baud rate (device default baud rate by default)")
+			;
+	}
+	bool SerialTarget::checkOptions(po::variables_map &variable_map)
+	{
+		m_port_set = variable_map.count("port") > 0;
+		m_baud_rate_set = variable_map.count("baud") > 0;
+		if (m_baud_rate_set && mcp2200::SerialPort::toStandardBaudRate(m_baud_rate) == 0){
+			cerr << "unsupported baud rate " << m_baud_rate << "\n";
+			return false;
+		}
+		return true;
+	}
+	bool SerialTarget::isBaudRateSet() const
+	{
+		return m_baud_rate_set;
+	}
+	int SerialTarget::getBaudRate() const
+	{
+		return m_baud_rate;
+	}
+	int SerialTarget::getPortBaudRate() const
+	{
+		return m_port_baud_rate;
+	}
+	bool SerialTarget::findPath(Target &target, string &path)
+	{
+		if (m_port_set){
+			path = m_port;
+			return true;
+		}
+		string hidraw_path;
+		if (!target.findPath(hidraw_path)){
+			cerr << "could not find device path (" << target << ")\n";
+			return false;
+		}
+		if (!mcp2200::SerialPort::findPath(hidraw_path, path)){
+			cerr << "could not find serial port of " << hidraw_path << "\n";
+			return false;
+		}
+		return true;
+	}
+	bool SerialTarget::open(Target &target, mcp2200::Device &device, mcp2200::SerialPort &port)
+	{
+		string path;
+		if (!findPath(target, path)) return false;
+		mcp2200::Command response;
+		if (!device.readAll(response)){
+			cerr << "could not read device configuration\n";
+			return false;
+		}
+		int baud_rate = m_baud_rate_set ? m_baud_rate : response.getBaudRate();
+		if (!port.open(path)){
+			cerr << "could not open serial port (" << path << ")\n";
+			return false;
+		}
+		if (!port.configure(baud_rate, response.getFlowControl())){
+			cerr << "could not configure serial port (" << path << ", baud rate " << baud_rate << ")\n";
+			port.close();
+			return false;
+		}
+		m_port_baud_rate = baud_rate;
+		return true;
+	}
+}
+#endif
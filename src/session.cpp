@@ -0,0 +1,232 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "session.h"
+#include "reenumeration.h"
+#include <thread>
+using namespace std;
+namespace mcp2200
+{
+	Session::Session():
+		m_vendor_id(defaultVendorId),
+		m_product_id(defaultProductId),
+		m_target_set(false),
+		m_connected(false),
+		m_configuration_set(false),
+		m_outputs_set(false),
+		m_reconnect_timeout(0)
+	{
+	}
+	bool Session::open(uint16_t vendor_id, uint16_t product_id, const string &serial)
+	{
+		close();
+		m_vendor_id = vendor_id;
+		m_product_id = product_id;
+		m_serial = serial;
+		m_target_set = true;
+		m_connected = openBySerial();
+		if (m_connected && m_serial.empty())
+			m_device.getSerial(m_serial);
+		return m_connected;
+	}
+	bool Session::attach(uint16_t vendor_id, uint16_t product_id)
+	{
+		// Device was opened by the caller, serial and path identify it when it has to be reopened.
+		if (!m_device.isOpen()) return false;
+		m_vendor_id = vendor_id;
+		m_product_id = product_id;
+		m_serial.clear();
+		m_path.clear();
+		m_device.getSerial(m_serial);
+		m_target_set = true;
+		if (!m_serial.empty()){
+			DeviceSnapshot devices;
+			devices.find(m_vendor_id, m_product_id);
+			for (size_t i = 0; i < devices.size(); i++){
+				if (devices[i].serial != m_serial) continue;
+				m_path = devices[i].path;
+				break;
+			}
+		}
+		m_connected = true;
+		m_configuration_set = m_outputs_set = false;
+		return true;
+	}
+	void Session::close()
+	{
+		m_device.close();
+		m_target_set = false;
+		m_connected = false;
+		m_configuration_set = m_outputs_set = false;
+		m_path.clear();
+	}
+	bool Session::isConnected() const
+	{
+		return m_connected;
+	}
+	void Session::record(const Command &command)
+	{
+		if (command.command_type == static_cast<uint8_t>(CommandType::configure)){
+			m_configuration = command;
+			m_configuration_set = true;
+		}else if (command.command_type == static_cast<uint8_t>(CommandType::set_clear_outputs)){
+			m_outputs = command;
+			m_outputs_set = true;
+		}
+	}
+	bool Session::write(const Command &command)
+	{
+		record(command);
+		for (int attempt = 0; attempt < 2; attempt++){
+			if (!m_connected && !reconnect(m_reconnect_timeout)) return false;
+			if (m_device.write(command)) return true;
+			disconnect("write failed");
+		}
+		return false;
+	}
+	bool Session::readAll(Command &response)
+	{
+		for (int attempt = 0; attempt < 2; attempt++){
+			if (!m_connected && !reconnect(m_reconnect_timeout)) return false;
+			if (m_device.readAll(response)) return true;
+			disconnect("read failed");
+		}
+		return false;
+	}
+	bool Session::capture()
+	{
+		// Current device state replaces recorded commands, so changes made directly through getDevice() are replayed too.
+		Command response;
+		if (!readAll(response)) return false;
+		Command configuration = response;
+		configuration.setCommand(CommandType::configure);
+		record(configuration);
+		uint8_t values = response.getGpioValues();
+		Command outputs = {};
+		outputs
+			.setCommand(CommandType::set_clear_outputs)
+			.setGpioValues(values, ~values)
+			;
+		record(outputs);
+		return true;
+	}
+	bool Session::setGpioValues(uint8_t values)
+	{
+		Command command = {};
+		command
+			.setCommand(CommandType::set_clear_outputs)
+			.setGpioValues(values, ~values)
+			;
+		return write(command);
+	}
+	void Session::notifyRemoved(const string &path)
+	{
+		if (m_connected && !m_path.empty() && path == m_path)
+			disconnect("device removed");
+	}
+	void Session::disconnect(const char *reason)
+	{
+		m_device.close();
+		m_connected = false;
+		m_disconnected = chrono::steady_clock::now();
+		m_outages.push_back(Outage{reason, -1});
+	}
+	bool Session::openBySerial()
+	{
+		if (m_opener) return m_opener(m_device, m_path);
+		DeviceSnapshot devices;
+		devices.find(m_vendor_id, m_product_id);
+		for (size_t i = 0; i < devices.size(); i++){
+			if (!m_serial.empty() && devices[i].serial != m_serial) continue;
+			string path(devices[i].path);
+			if (!m_device.open(path)) continue;
+			m_path = path;
+			return true;
+		}
+		return false;
+	}
+	bool Session::waitForOpener(int timeout_ms)
+	{
+		auto end = chrono::steady_clock::now() + chrono::milliseconds(timeout_ms);
+		while (!m_opener(m_device, m_path)){
+			if (chrono::steady_clock::now() >= end) return false;
+			this_thread::sleep_for(chrono::milliseconds(5));
+		}
+		return true;
+	}
+	bool Session::replay()
+	{
+		if (m_configuration_set && !m_device.write(m_configuration)) return false;
+		if (m_outputs_set && !m_device.write(m_outputs)) return false;
+		return true;
+	}
+	bool Session::reconnect(int timeout_ms)
+	{
+		if (m_connected) return true;
+		if (!m_target_set) return false;
+		if (m_opener){
+			if (!waitForOpener(timeout_ms)) return false;
+		}else{
+			// Monitor is started before the first attempt, so a device appearing in between is not missed.
+			Reenumeration reenumeration;
+			reenumeration.start(m_serial, m_vendor_id, m_product_id, false);
+			if (!openBySerial()){
+				if (!reenumeration.wait(m_device, timeout_ms)) return false;
+				m_path = reenumeration.getPath();
+			}
+		}
+		if (!replay()){
+			m_device.close();
+			return false;
+		}
+		m_connected = true;
+		if (!m_outages.empty() && m_outages.back().downtime_us < 0)
+			m_outages.back().downtime_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - m_disconnected).count();
+		return true;
+	}
+	void Session::setReconnectTimeout(int timeout_ms)
+	{
+		m_reconnect_timeout = timeout_ms;
+	}
+	void Session::setOpener(Opener opener)
+	{
+		m_opener = opener;
+	}
+	Device &Session::getDevice()
+	{
+		return m_device;
+	}
+	const string &Session::getSerial() const
+	{
+		return m_serial;
+	}
+	const string &Session::getPath() const
+	{
+		return m_path;
+	}
+	const vector<Session::Outage> &Session::getOutages() const
+	{
+		return m_outages;
+	}
+}
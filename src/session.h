@@ -0,0 +1,82 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_SESSION_H_
+#define HEADER_SESSION_H_
+#include "mcp2200.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+namespace mcp2200
+{
+	// Device connection which survives disconnects. Failed I/O or removal closes the handle, the device is then reopened by serial
+	// number and the last written configuration and outputs are written again before the failed operation is retried.
+	struct Session
+	{
+		struct Outage
+		{
+			std::string reason;
+			int64_t downtime_us;
+		};
+		// Opens the device and sets its path, replaces search by serial number when the device is reached through another transport.
+		typedef std::function<bool(Device &device, std::string &path)> Opener;
+		Session();
+		bool open(uint16_t vendor_id, uint16_t product_id, const std::string &serial);
+		bool attach(uint16_t vendor_id, uint16_t product_id);
+		void close();
+		bool isConnected() const;
+		bool write(const Command &command);
+		bool readAll(Command &response);
+		bool capture();
+		bool setGpioValues(uint8_t values);
+		void notifyRemoved(const std::string &path);
+		bool reconnect(int timeout_ms);
+		void setReconnectTimeout(int timeout_ms);
+		void setOpener(Opener opener);
+		Device &getDevice();
+		const std::string &getSerial() const;
+		const std::string &getPath() const;
+		const std::vector<Outage> &getOutages() const;
+		private:
+		Device m_device;
+		uint16_t m_vendor_id, m_product_id;
+		std::string m_serial, m_path;
+		bool m_target_set, m_connected, m_configuration_set, m_outputs_set;
+		int m_reconnect_timeout;
+		Command m_configuration, m_outputs;
+		std::vector<Outage> m_outages;
+		std::chrono::steady_clock::time_point m_disconnected;
+		Opener m_opener;
+		void record(const Command &command);
+		void disconnect(const char *reason);
+		bool openBySerial();
+		bool waitForOpener(int timeout_ms);
+		bool replay();
+		Session(const Session &) = delete;
+		void operator=(const Session &) = delete;
+	};
+}
+#endif /* HEADER_SESSION_H_ */
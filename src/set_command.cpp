@@ -31,7 +31,7 @@ namespace po = boost::program_options;
 namespace command_line
 {
 	SetCommand::SetCommand():
-		Command("set", "set GPIO state", "VALUES")
+		DeviceCommand("set", "set GPIO state", "VALUES")
 	{
 	}
 	SetCommand::~SetCommand()
@@ -39,7 +39,7 @@ namespace command_line
 	}
 	void SetCommand::addOptions(po::options_description &options, po::options_description &hidden_options)
 	{
-		m_target.addOptions(options, hidden_options);
+		DeviceCommand::addOptions(options, hidden_options);
 		options.add_options()
 			("pin", po::value<int>(&m_pin), "pin index (starting from 0)")
 			("value", po::value<bool>(&m_value), "pin value")
@@ -55,7 +55,7 @@ namespace command_line
 	}
 	bool SetCommand::checkOptions(po::variables_map &variable_map)
 	{
-		if (!m_target.checkOptions(variable_map)) return false;
+		if (!DeviceCommand::checkOptions(variable_map)) return false;
 		m_all_values = variable_map.count("values") > 0;
 		m_one_pin = (variable_map.count("pin") > 0 && variable_map.count("value") > 0);
 		m_has_mask = variable_map.count("mask") > 0;
@@ -71,12 +71,8 @@ namespace command_line
 		}
 		return true;
 	}
-	bool SetCommand::run()
+	bool SetCommand::run(mcp2200::Device &device)
 	{
-		mcp2200::Device device;
-		if (!m_target.open(device)){
-			return false;
-		}
 		if (!device.writeAfterRead([&](mcp2200::Command &command){
 			command.setCommand(mcp2200::CommandType::set_clear_outputs);
 			uint8_t gpio_mask = command.getIoMask();
@@ -91,10 +87,8 @@ namespace command_line
 			}
 			return true;
 		})){
-			device.close();
 			return false;
 		}
-		device.close();
-		return false;
+		return true;
 	}
 }
@@ -24,23 +24,22 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #ifndef HEADER_SET_COMMAND_H_
 #define HEADER_SET_COMMAND_H_
-#include "command.h"
-#include "target.h"
+#include "device_command.h"
 #include "helpers.h"
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/variables_map.hpp>
 namespace command_line
 {
-	struct SetCommand: public Command
+	struct SetCommand: public DeviceCommand
 	{
 		SetCommand();
 		virtual ~SetCommand();
 		virtual void addOptions(boost::program_options::options_description &options, boost::program_options::options_description &hidden_options);
 		virtual void addPositionalOptions(boost::program_options::positional_options_description &positional_options);
 		virtual bool checkOptions(boost::program_options::variables_map &variable_map);
-		virtual bool run();
+		using DeviceCommand::run;
+		virtual bool run(mcp2200::Device &device);
 		private:
-		Target m_target;
 		BitMap<uint8_t> m_values, m_mask;
 		bool m_value, m_all_values, m_one_pin, m_has_mask;
 		int m_pin;
@@ -32,7 +32,7 @@ namespace po = boost::program_options;
 namespace command_line
 {
 	SetEepromCommand::SetEepromCommand():
-		Command("set-eeprom", "set EEPROM value", "VALUE")
+		DeviceCommand("set-eeprom", "set EEPROM value", "VALUE")
 	{
 	}
 	SetEepromCommand::~SetEepromCommand()
@@ -41,7 +41,7 @@ namespace command_line
 	void SetEepromCommand::addOptions(po::options_description &options, po::options_description &hidden_options)
 	{
 		using namespace boost::program_options;
-		m_target.addOptions(options, hidden_options);
+		DeviceCommand::addOptions(options, hidden_options);
 		options.add_options()
 			("address,a", po::value<int>(&m_address)->notifier([](int value){ if (value < 0 || value > 255) throw validation_error(validation_error::invalid_option_value, "address", to_string(value)); }), "EEPROM address [0; 255]")
 		;
@@ -55,17 +55,10 @@ namespace command_line
 	}
 	bool SetEepromCommand::checkOptions(po::variables_map &variable_map)
 	{
-		return m_target.checkOptions(variable_map);
+		return DeviceCommand::checkOptions(variable_map);
 	}
-	bool SetEepromCommand::run()
+	bool SetEepromCommand::run(mcp2200::Device &device)
 	{
-		mcp2200::Device device;
-		if (!m_target.open(device)){
-			return false;
-		}
-		if (device.writeEeprom(m_address, m_value)){
-		}
-		device.close();
-		return true;
+		return device.writeEeprom(m_address, m_value);
 	}
 }
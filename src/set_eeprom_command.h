@@ -24,22 +24,21 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #ifndef HEADER_SET_EEPROM_COMMAND_H_
 #define HEADER_SET_EEPROM_COMMAND_H_
-#include "command.h"
-#include "target.h"
+#include "device_command.h"
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/variables_map.hpp>
 namespace command_line
 {
-	struct SetEepromCommand: public Command
+	struct SetEepromCommand: public DeviceCommand
 	{
 		SetEepromCommand();
 		virtual ~SetEepromCommand();
 		virtual void addOptions(boost::program_options::options_description &options, boost::program_options::options_description &hidden_options);
 		virtual void addPositionalOptions(boost::program_options::positional_options_description &positional_options);
 		virtual bool checkOptions(boost::program_options::variables_map &variable_map);
-		virtual bool run();
+		using DeviceCommand::run;
+		virtual bool run(mcp2200::Device &device);
 		private:
-		Target m_target;
 		int m_address;
 		HexOption<uint8_t> m_value;
 	};
@@ -0,0 +1,109 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef LINUX_BUILD
+#include "sysfs_enumerator.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <filesystem>
+using namespace std;
+namespace fs = std::filesystem;
+namespace mcp2200
+{
+	static bool readAttribute(const fs::path &path, string &value)
+	{
+		int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) return false;
+		char buffer[256];
+		ssize_t size;
+		while ((size = ::read(fd, buffer, sizeof(buffer))) < 0 && errno == EINTR);
+		::close(fd);
+		if (size < 0) return false;
+		while (size > 0 && (buffer[size - 1] == '\n' || buffer[size - 1] == '\0'))
+			size--;
+		value.assign(buffer, size);
+		return true;
+	}
+	SysfsEnumerator::SysfsEnumerator(const string &sysfs_root):
+		m_sysfs_root(sysfs_root)
+	{
+	}
+	bool SysfsEnumerator::parseHidName(const string &name, uint16_t &vendor_id, uint16_t &product_id)
+	{
+		// HID device directories are named BBBB:VVVV:PPPP.NNNN, bus 0003 is USB.
+		if (name.size() < 15 || name[4] != ':' || name[9] != ':' || name[14] != '.') return false;
+		if (name.compare(0, 4, "0003") != 0) return false;
+		char *end;
+		unsigned long vendor = strtoul(name.c_str() + 5, &end, 16);
+		if (end != name.c_str() + 9) return false;
+		unsigned long product = strtoul(name.c_str() + 10, &end, 16);
+		if (end != name.c_str() + 14) return false;
+		vendor_id = static_cast<uint16_t>(vendor);
+		product_id = static_cast<uint16_t>(product);
+		return true;
+	}
+	bool SysfsEnumerator::find(uint16_t vendor_id, uint16_t product_id, vector<DeviceInformation> &devices) const
+	{
+		devices.clear();
+		error_code ec;
+		fs::directory_iterator iterator(fs::path(m_sysfs_root) / "class" / "hidraw", ec);
+		if (ec) return false;
+		for (auto &entry: iterator){
+			// Link target name is enough to filter by IDs, so nothing is read from unrelated devices.
+			auto device_link = entry.path() / "device";
+			auto target = fs::read_symlink(device_link, ec);
+			if (ec) continue;
+			uint16_t device_vendor_id, device_product_id;
+			if (!parseHidName(target.filename().string(), device_vendor_id, device_product_id)) continue;
+			if ((vendor_id != 0 && device_vendor_id != vendor_id) || (product_id != 0 && device_product_id != product_id)) continue;
+			auto hid_device = fs::canonical(device_link, ec);
+			if (ec) continue;
+			auto usb_device = hid_device.parent_path().parent_path();
+			string serial, manufacturer, product, release;
+			readAttribute(usb_device / "serial", serial);
+			readAttribute(usb_device / "manufacturer", manufacturer);
+			readAttribute(usb_device / "product", product);
+			readAttribute(usb_device / "bcdDevice", release);
+			auto path = (fs::path("/dev") / entry.path().filename()).string();
+			devices.emplace_back(path.c_str(), serial.c_str(), manufacturer.c_str(), product.c_str(), static_cast<uint16_t>(strtoul(release.c_str(), nullptr, 16)));
+		}
+		// Directory order is arbitrary, hidraw numbers are sorted numerically.
+		sort(devices.begin(), devices.end(), [](const DeviceInformation &a, const DeviceInformation &b){
+			if (a.path.size() != b.path.size()) return a.path.size() < b.path.size();
+			return a.path < b.path;
+		});
+		return true;
+	}
+	bool SysfsEnumerator::getIds(const string &device_path, uint16_t &vendor_id, uint16_t &product_id) const
+	{
+		error_code ec;
+		auto target = fs::read_symlink(fs::path(m_sysfs_root) / "class" / "hidraw" / fs::path(device_path).filename() / "device", ec);
+		if (ec) return false;
+		return parseHidName(target.filename().string(), vendor_id, product_id);
+	}
+}
+#endif
@@ -0,0 +1,44 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_SYSFS_ENUMERATOR_H_
+#define HEADER_SYSFS_ENUMERATOR_H_
+#include "mcp2200.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+namespace mcp2200
+{
+	// Lists hidraw devices by reading attributes of their USB device from sysfs instead of opening every hidraw node.
+	struct SysfsEnumerator
+	{
+		SysfsEnumerator(const std::string &sysfs_root = "/sys");
+		bool find(uint16_t vendor_id, uint16_t product_id, std::vector<DeviceInformation> &devices) const;
+		bool getIds(const std::string &device_path, uint16_t &vendor_id, uint16_t &product_id) const;
+		static bool parseHidName(const std::string &name, uint16_t &vendor_id, uint16_t &product_id);
+		private:
+		std::string m_sysfs_root;
+	};
+}
+#endif /* HEADER_SYSFS_ENUMERATOR_H_ */
@@ -24,6 +24,8 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "target.h"
 #include "mcp2200.h"
+#include "serial_index.h"
+#include "sysfs_enumerator.h"
 #include <boost/program_options/option.hpp>
 #include <iostream>
 namespace po = boost::program_options;
@@ -65,6 +67,10 @@ namespace command_line
 	{
 		return m_serial_set;
 	}
+	bool Target::isSet() const
+	{
+		return m_path_set || m_serial_set || areIdsSet();
+	}
 	const std::string &Target::getPath() const
 	{
 		return m_path;
@@ -73,6 +79,53 @@ namespace command_line
 	{
 		return m_serial;
 	}
+	bool Target::findPath(std::string &path)
+	{
+		if (isPathSet()){
+			path = getPath();
+			return true;
+		}
+		mcp2200::DeviceSnapshot devices;
+		devices.find(getVendorId(), getProductId());
+		for (size_t i = 0; i < devices.size(); i++){
+			if (isSerialSet() && devices[i].serial != getSerial()) continue;
+			path = devices[i].path;
+			return true;
+		}
+		return false;
+	}
+	bool Target::openBySerial(mcp2200::Device &device)
+	{
+#ifdef LINUX_BUILD
+		// Indexed path is only trusted if the device there has the requested IDs and reports the requested serial.
+		mcp2200::SerialIndex index;
+		bool index_open = index.open();
+		string path, serial;
+		uint16_t vendor_id, product_id;
+		if (index_open && index.lookup(getVendorId(), getProductId(), getSerial(), path)){
+			if (mcp2200::SysfsEnumerator().getIds(path, vendor_id, product_id) && vendor_id == getVendorId() && product_id == getProductId()){
+				if (device.open(path) && device.getSerial(serial) && serial == getSerial())
+					return true;
+				device.close();
+			}
+		}
+#endif
+		mcp2200::Device enumerator;
+		enumerator.find(getVendorId(), getProductId());
+		vector<mcp2200::DeviceInformation> devices;
+		for (size_t i = 0; i < enumerator.getCount(); i++)
+			devices.push_back(enumerator[i]);
+#ifdef LINUX_BUILD
+		if (index_open)
+			index.replace(getVendorId(), getProductId(), devices);
+#endif
+		for (auto &information: devices){
+			if (information.serial != getSerial()) continue;
+			if (device.open(information))
+				return true;
+		}
+		return false;
+	}
 	bool Target::open(mcp2200::Device &device)
 	{
 		if (isPathSet()){
@@ -84,7 +137,7 @@ namespace command_line
 			}
 		}
 		if (isSerialSet()){
-			if (device.open(getVendorId(), getProductId(), getSerial().c_str())){
+			if (openBySerial(device)){
 				return true;
 			}else{
 				cerr << "could not open device (" << *this << ", serial:" << getSerial() << ")\n";
@@ -29,8 +29,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/variables_map.hpp>
 #include <string>
+#include <iostream>
 namespace command_line
 {
+	std::ostream &operator<<(std::ostream &stream, const VendorProduct &vendor_product);
 	struct Target: public VendorProduct
 	{
 		Target();
@@ -38,10 +40,13 @@ namespace command_line
 		bool checkOptions(boost::program_options::variables_map &variable_map);
 		bool isPathSet() const;
 		bool isSerialSet() const;
+		bool isSet() const;
 		const std::string &getPath() const;
 		const std::string &getSerial() const;
 		bool open(mcp2200::Device &device);
+		bool findPath(std::string &path);
 		private:
+		bool openBySerial(mcp2200::Device &device);
 		std::string m_serial, m_path;
 		bool m_serial_set, m_path_set;
 	};
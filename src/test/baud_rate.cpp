@@ -0,0 +1,45 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "mcp2200.h"
+using namespace mcp2200;
+using namespace std;
+BOOST_AUTO_TEST_SUITE(baud_rate)
+BOOST_AUTO_TEST_CASE(divisor)
+{
+	BOOST_CHECK_EQUAL(toBaudRateDivisor(9600), 1249);
+	BOOST_CHECK_EQUAL(fromBaudRateDivisor(1249), 9600);
+	BOOST_CHECK_EQUAL(fromBaudRateDivisor(toBaudRateDivisor(115200)), 115384);
+}
+BOOST_AUTO_TEST_CASE(command)
+{
+	for (int baud_rate: {300, 1200, 9600, 19200}){
+		Command command;
+		command.setBaudRate(baud_rate);
+		BOOST_CHECK_EQUAL(command.getBaudRate(), baud_rate);
+	}
+}
+BOOST_AUTO_TEST_SUITE_END()
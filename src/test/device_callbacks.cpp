@@ -0,0 +1,228 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "mcp2200.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <cstdlib>
+#include <new>
+using namespace mcp2200;
+using namespace std;
+static atomic<size_t> allocation_count(0);
+void *operator new(size_t size)
+{
+	allocation_count++;
+	if (void *pointer = malloc(size ? size : 1))
+		return pointer;
+	throw bad_alloc();
+}
+void operator delete(void *pointer) noexcept
+{
+	free(pointer);
+}
+void operator delete(void *pointer, size_t) noexcept
+{
+	free(pointer);
+}
+// Answers read_all with a fixed configuration and remembers the last written command.
+struct FakeTransport: public Transport
+{
+	Command state, last;
+	size_t writes;
+	bool pending;
+	FakeTransport():
+		writes(0),
+		pending(false)
+	{
+		state.setCommand(CommandType::read_all);
+		state.read_all_response.io_directions = 0xf0;
+		state.read_all_response.gpio_values = 0x0a;
+	}
+	virtual bool write(const Command &command)
+	{
+		last = command;
+		writes++;
+		pending = command.command_type == static_cast<uint8_t>(CommandType::read_all);
+		return true;
+	}
+	virtual bool read(Command &response, int)
+	{
+		if (!pending) return false;
+		response = state;
+		pending = false;
+		return true;
+	}
+};
+BOOST_AUTO_TEST_SUITE(device_callbacks)
+BOOST_AUTO_TEST_CASE(closed_device_does_not_call_back)
+{
+	Device device;
+	bool called = false;
+	BOOST_CHECK(!device.configure([&called](Command &){
+		called = true;
+	}));
+	BOOST_CHECK(!device.writeAfterRead([&called](Command &){
+		called = true;
+		return true;
+	}));
+	BOOST_CHECK(!called);
+}
+BOOST_AUTO_TEST_CASE(configure_does_not_allocate)
+{
+	FakeTransport transport;
+	Device device;
+	BOOST_REQUIRE(device.open(transport));
+	// Capture is larger than any std::function small buffer.
+	uint8_t values[64] = {};
+	values[0] = 0x3c;
+	uint8_t io_directions = 0;
+	size_t allocations = allocation_count;
+	bool result = device.configure([values, &io_directions](Command &command){
+		io_directions = command.getIoDirections();
+		command.setIoDirections(values[0]);
+	});
+	BOOST_CHECK_EQUAL(allocation_count - allocations, 0u);
+	BOOST_CHECK(result);
+	BOOST_CHECK_EQUAL(io_directions, 0xf0);
+	BOOST_CHECK_EQUAL(transport.writes, 2u);
+	BOOST_CHECK_EQUAL(transport.last.command_type, static_cast<uint8_t>(CommandType::configure));
+}
+BOOST_AUTO_TEST_CASE(configure_arguments_do_not_allocate)
+{
+	FakeTransport transport;
+	Device device;
+	BOOST_REQUIRE(device.open(transport));
+	bool result = true;
+	size_t allocations = allocation_count;
+	for (int i = 0; i < 1000; i++){
+		result &= device.configure(0xff, 9600, LedMode::blink, LedMode::toggle, false, true, false, false);
+		result &= device.setIoDirections(0x0f);
+		result &= device.setGpioValues(0x55);
+	}
+	BOOST_CHECK_EQUAL(allocation_count - allocations, 0u);
+	BOOST_CHECK(result);
+	BOOST_CHECK_EQUAL(transport.writes, 5000u);
+}
+BOOST_AUTO_TEST_CASE(write_after_read_does_not_allocate)
+{
+	FakeTransport transport;
+	Device device;
+	BOOST_REQUIRE(device.open(transport));
+	uint8_t values[64] = {};
+	values[0] = 0x55;
+	uint8_t gpio_values = 0;
+	size_t allocations = allocation_count;
+	bool result = device.writeAfterRead([values, &gpio_values](Command &command){
+		gpio_values = command.getGpioValues();
+		command
+			.setCommand(CommandType::set_clear_outputs)
+			.setGpioValues(values[0], ~values[0]);
+		return true;
+	});
+	BOOST_CHECK_EQUAL(allocation_count - allocations, 0u);
+	BOOST_CHECK(result);
+	BOOST_CHECK_EQUAL(gpio_values, 0x0a);
+	BOOST_CHECK_EQUAL(transport.last.command_type, static_cast<uint8_t>(CommandType::set_clear_outputs));
+	BOOST_CHECK_EQUAL(transport.last.set_clear_outputs.set, 0x55);
+	device.close();
+	BOOST_CHECK(!device.isOpen());
+	BOOST_CHECK(!device.setGpioValues(0x55));
+}
+BOOST_AUTO_TEST_CASE(callback_benchmark)
+{
+	// Compares template callbacks with the former interface, which wrapped every callback in a std::function.
+	FakeTransport transport;
+	Device device;
+	BOOST_REQUIRE(device.open(transport));
+	uint8_t values[64] = {};
+	auto actions = [values](Command &command){
+		command.setIoDirections(values[0]);
+	};
+	const int iterations = 100000;
+	using clock = chrono::steady_clock;
+	bool result = true;
+	size_t allocations = allocation_count;
+	auto start = clock::now();
+	for (int i = 0; i < iterations; i++){
+		values[0] = static_cast<uint8_t>(i);
+		result &= device.configure(actions);
+	}
+	auto template_time = clock::now() - start;
+	size_t template_allocations = allocation_count - allocations;
+	allocations = allocation_count;
+	start = clock::now();
+	for (int i = 0; i < iterations; i++){
+		values[0] = static_cast<uint8_t>(i);
+		result &= device.configure(function<void(Command &)>(actions));
+	}
+	auto function_time = clock::now() - start;
+	size_t function_allocations = allocation_count - allocations;
+	BOOST_CHECK(result);
+	BOOST_CHECK_EQUAL(template_allocations, 0u);
+	BOOST_CHECK_EQUAL(function_allocations, static_cast<size_t>(iterations));
+	double template_ns = chrono::duration<double, nano>(template_time).count() / iterations;
+	double function_ns = chrono::duration<double, nano>(function_time).count() / iterations;
+	BOOST_TEST_MESSAGE("configure: " << template_ns << " ns with template callback, " << function_ns << " ns with std::function");
+}
+BOOST_AUTO_TEST_SUITE_END()
+BOOST_AUTO_TEST_SUITE(device_snapshot)
+static void addDevices(DeviceSnapshot &snapshot)
+{
+	for (int i = 0; i < 8; i++)
+		snapshot.add("/dev/hidraw3", L"0000988086", L"Microchip Technology Inc.", L"MCP2200 USB Serial Port Emulator", 0x0101);
+}
+BOOST_AUTO_TEST_CASE(strings_are_converted_to_utf8)
+{
+	DeviceSnapshot snapshot;
+	snapshot.add("/dev/hidraw3", L"0000988086", L"M\u00fcnchen \u20ac", nullptr, 0x0101);
+	BOOST_REQUIRE_EQUAL(snapshot.size(), 1u);
+	BOOST_CHECK_EQUAL(snapshot[0].path, "/dev/hidraw3");
+	BOOST_CHECK_EQUAL(snapshot[0].serial, "0000988086");
+	BOOST_CHECK_EQUAL(snapshot[0].manufacturer, "M\xc3\xbcnchen \xe2\x82\xac");
+	BOOST_CHECK(snapshot[0].product.empty());
+	BOOST_CHECK_EQUAL(snapshot[0].toInformation().release_number, 0x0101);
+}
+BOOST_AUTO_TEST_CASE(repeated_enumeration_does_not_allocate)
+{
+	size_t allocations = allocation_count;
+	vector<DeviceInformation> copies;
+	for (int i = 0; i < 8; i++)
+		copies.emplace_back("/dev/hidraw3", "0000988086", "Microchip Technology Inc.", "MCP2200 USB Serial Port Emulator", 0x0101);
+	size_t copy_allocations = allocation_count - allocations;
+	DeviceSnapshot snapshot;
+	addDevices(snapshot);
+	snapshot.clear();
+	allocations = allocation_count;
+	addDevices(snapshot);
+	size_t snapshot_allocations = allocation_count - allocations;
+	BOOST_TEST_MESSAGE("allocations for 8 devices: " << copy_allocations << " with DeviceInformation, " << snapshot_allocations << " with DeviceSnapshot");
+	BOOST_CHECK_GT(copy_allocations, 8u);
+	BOOST_CHECK_EQUAL(snapshot_allocations, 0u);
+	BOOST_CHECK_EQUAL(snapshot.size(), 8u);
+	BOOST_CHECK_EQUAL(snapshot[7].product, "MCP2200 USB Serial Port Emulator");
+}
+BOOST_AUTO_TEST_SUITE_END()
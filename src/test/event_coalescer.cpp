@@ -0,0 +1,66 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "event_coalescer.h"
+#include <string>
+using namespace mcp2200;
+using namespace std;
+BOOST_AUTO_TEST_SUITE(event_coalescer)
+BOOST_AUTO_TEST_CASE(burst)
+{
+	EventCoalescer<string, string> coalescer;
+	BOOST_CHECK(coalescer.push("/dev/hidraw1", "add"));
+	BOOST_CHECK(!coalescer.push("/dev/hidraw2", "add"));
+	BOOST_CHECK(!coalescer.push("/dev/hidraw1", "remove"));
+	BOOST_CHECK(!coalescer.push("/dev/hidraw1", "add again"));
+	auto events = coalescer.take();
+	BOOST_REQUIRE_EQUAL(events.size(), 3u);
+	BOOST_CHECK_EQUAL(events[0], "add");
+	BOOST_CHECK_EQUAL(events[1], "add again");
+	BOOST_CHECK_EQUAL(events[2], "add");
+	BOOST_CHECK(coalescer.push("/dev/hidraw3", "remove"));
+	BOOST_CHECK_EQUAL(coalescer.take().size(), 1u);
+	BOOST_CHECK(coalescer.take().empty());
+	auto statistics = coalescer.getStatistics();
+	BOOST_CHECK_EQUAL(statistics.events, 5u);
+	BOOST_CHECK_EQUAL(statistics.batches, 2u);
+	BOOST_CHECK_EQUAL(statistics.merged, 1u);
+	BOOST_CHECK_EQUAL(statistics.getSavedRefreshes(), 3u);
+}
+BOOST_AUTO_TEST_CASE(remove_before_add)
+{
+	EventCoalescer<string, string> coalescer;
+	BOOST_CHECK(coalescer.push("/dev/hidraw1", "remove"));
+	BOOST_CHECK(!coalescer.push("/dev/hidraw1", "add"));
+	BOOST_CHECK(!coalescer.push("/dev/hidraw1", "remove again"));
+	BOOST_CHECK(!coalescer.push("/dev/hidraw1", "add again"));
+	auto events = coalescer.take();
+	BOOST_REQUIRE_EQUAL(events.size(), 2u);
+	BOOST_CHECK_EQUAL(events[0], "remove");
+	BOOST_CHECK_EQUAL(events[1], "add again");
+	BOOST_CHECK_EQUAL(coalescer.getStatistics().merged, 2u);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,136 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "frame_decoder.h"
+#include <string>
+#include <vector>
+using namespace mcp2200;
+using namespace std;
+struct CollectedFrame
+{
+	string data;
+	uint64_t time_us;
+	bool valid;
+};
+struct Collector
+{
+	vector<CollectedFrame> frames;
+	void operator()(const Frame &frame)
+	{
+		string data(reinterpret_cast<const char *>(frame.data.first), frame.data.first_size);
+		data.append(reinterpret_cast<const char *>(frame.data.second), frame.data.second_size);
+		frames.push_back(CollectedFrame{data, frame.time_us, frame.valid});
+	}
+};
+static size_t write(FrameStage &stage, const string &data, uint64_t time_us, Collector &collector)
+{
+	return stage.write(reinterpret_cast<const uint8_t *>(data.data()), data.size(), time_us, collector);
+}
+BOOST_AUTO_TEST_SUITE(frame_decoder)
+BOOST_AUTO_TEST_CASE(lines)
+{
+	FrameStage stage(unique_ptr<FrameDecoder>(new LineDecoder(8)), 16);
+	Collector collector;
+	write(stage, "abc\r\nde", 10, collector);
+	write(stage, "f\n\n0123456789", 20, collector);
+	BOOST_REQUIRE_EQUAL(collector.frames.size(), 4u);
+	BOOST_CHECK_EQUAL(collector.frames[0].data, "abc");
+	BOOST_CHECK_EQUAL(collector.frames[0].time_us, 10u);
+	BOOST_CHECK_EQUAL(collector.frames[1].data, "def");
+	BOOST_CHECK_EQUAL(collector.frames[1].time_us, 10u);
+	BOOST_CHECK_EQUAL(collector.frames[2].data, "");
+	BOOST_CHECK_EQUAL(collector.frames[3].data, "01234567");
+	BOOST_CHECK_EQUAL(stage.getDiscardedBytes(), 0u);
+}
+BOOST_AUTO_TEST_CASE(line_across_wraparound)
+{
+	FrameStage stage(unique_ptr<FrameDecoder>(new LineDecoder(16)), 8);
+	Collector collector;
+	write(stage, "abcde\n", 0, collector);
+	write(stage, "fghij\n", 1, collector);
+	BOOST_REQUIRE_EQUAL(collector.frames.size(), 2u);
+	BOOST_CHECK_EQUAL(collector.frames[1].data, "fghij");
+}
+BOOST_AUTO_TEST_CASE(length_prefixed)
+{
+	FrameStage stage(unique_ptr<FrameDecoder>(new LengthPrefixedDecoder(2, true, 16)));
+	Collector collector;
+	write(stage, string("\x00\x03" "abc\x00", 6), 0, collector);
+	write(stage, string("\x02xy\xff\xff\x00\x01z\x00\x00", 11), 5, collector);
+	BOOST_REQUIRE_EQUAL(collector.frames.size(), 4u);
+	BOOST_CHECK_EQUAL(collector.frames[0].data, "abc");
+	BOOST_CHECK_EQUAL(collector.frames[1].data, "xy");
+	BOOST_CHECK_EQUAL(collector.frames[1].time_us, 0u);
+	BOOST_CHECK_EQUAL(collector.frames[2].data, "z");
+	BOOST_CHECK_EQUAL(collector.frames[3].data, "");
+	BOOST_CHECK_EQUAL(stage.getDiscardedBytes(), 2u);
+}
+BOOST_AUTO_TEST_CASE(buffer_fits_largest_frame)
+{
+	FrameStage stage(unique_ptr<FrameDecoder>(new LengthPrefixedDecoder(4, true, 100000)));
+	Collector collector;
+	string payload(100000, 'x');
+	write(stage, string("\x00\x01\x86\xa0", 4) + payload, 0, collector);
+	BOOST_REQUIRE_EQUAL(collector.frames.size(), 1u);
+	BOOST_CHECK(collector.frames[0].data == payload);
+	BOOST_CHECK_EQUAL(stage.getDiscardedBytes(), 0u);
+}
+BOOST_AUTO_TEST_CASE(modbus_gap)
+{
+	BOOST_CHECK_EQUAL(ModbusRtuDecoder::getGap(9600).count(), 4011);
+	BOOST_CHECK_EQUAL(ModbusRtuDecoder::getGap(115200).count(), 1750);
+	FrameStage stage(unique_ptr<FrameDecoder>(new ModbusRtuDecoder(9600)));
+	Collector collector;
+	// Read holding registers request with a valid CRC.
+	const string request("\x01\x03\x00\x00\x00\x0a\xc5\xcd", 8);
+	write(stage, request.substr(0, 3), 1000, collector);
+	write(stage, request.substr(3), 2000, collector);
+	BOOST_CHECK(collector.frames.empty());
+	BOOST_CHECK_EQUAL(stage.getTimeout(3000), 3011);
+	BOOST_CHECK(!stage.expire(6000, collector));
+	write(stage, string("\x01\x03\x00", 3), 7000, collector);
+	BOOST_CHECK(stage.expire(11100, collector));
+	BOOST_REQUIRE_EQUAL(collector.frames.size(), 2u);
+	BOOST_CHECK_EQUAL(collector.frames[0].data, request);
+	BOOST_CHECK_EQUAL(collector.frames[0].time_us, 1000u);
+	BOOST_CHECK(collector.frames[0].valid);
+	BOOST_CHECK_EQUAL(collector.frames[1].time_us, 7000u);
+	BOOST_CHECK(!collector.frames[1].valid);
+	BOOST_CHECK_EQUAL(stage.getInvalidFrames(), 1u);
+	BOOST_CHECK_EQUAL(stage.getTimeout(11100), -1);
+}
+BOOST_AUTO_TEST_CASE(modbus_max_length)
+{
+	FrameStage stage(unique_ptr<FrameDecoder>(new ModbusRtuDecoder(9600, 4)));
+	Collector collector;
+	write(stage, "abcdef", 0, collector);
+	BOOST_REQUIRE_EQUAL(collector.frames.size(), 1u);
+	BOOST_CHECK_EQUAL(collector.frames[0].data, "abcd");
+	BOOST_CHECK(stage.expire(10000, collector));
+	BOOST_REQUIRE_EQUAL(collector.frames.size(), 2u);
+	BOOST_CHECK_EQUAL(collector.frames[1].data, "ef");
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,95 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef LINUX_BUILD
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "loopback_benchmark.h"
+#include "serial_port.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+using namespace mcp2200;
+using namespace std;
+BOOST_AUTO_TEST_SUITE(loopback_benchmark)
+BOOST_AUTO_TEST_CASE(pattern)
+{
+	BOOST_CHECK_EQUAL(LoopbackBenchmark::getPatternByte(0), 0);
+	BOOST_CHECK_EQUAL(LoopbackBenchmark::getPatternByte(250), 250);
+	BOOST_CHECK_EQUAL(LoopbackBenchmark::getPatternByte(251), 0);
+}
+BOOST_AUTO_TEST_CASE(pseudo_terminal)
+{
+	// Data written to the master side is received on the slave side, which stands in for a looped back serial port.
+	int master = posix_openpt(O_RDWR | O_NOCTTY);
+	BOOST_REQUIRE(master >= 0);
+	BOOST_REQUIRE(grantpt(master) == 0 && unlockpt(master) == 0);
+	SerialPort port;
+	BOOST_REQUIRE(port.open(ptsname(master)));
+	BOOST_REQUIRE(port.configure(115200, false));
+	LoopbackBenchmark benchmark;
+	benchmark
+		.setLatencySamples(20)
+		.setThroughputBytes(10000)
+		.setTimeout(1000);
+	LoopbackResult result;
+	BOOST_REQUIRE(benchmark.run(master, port.getFd(), result));
+	BOOST_CHECK_EQUAL(result.latency_samples, 20u);
+	BOOST_CHECK_EQUAL(result.latency_timeouts, 0u);
+	BOOST_CHECK(result.latency_p50 <= result.latency_p99);
+	BOOST_CHECK(result.latency_p99 <= result.latency_max);
+	BOOST_CHECK_EQUAL(result.bytes_sent, 10000u);
+	BOOST_CHECK_EQUAL(result.bytes_received, 10000u);
+	BOOST_CHECK_EQUAL(result.errors, 0u);
+	BOOST_CHECK(result.throughput > 0);
+	close(master);
+}
+BOOST_AUTO_TEST_CASE(missing_data)
+{
+	int master = posix_openpt(O_RDWR | O_NOCTTY);
+	BOOST_REQUIRE(master >= 0);
+	BOOST_REQUIRE(grantpt(master) == 0 && unlockpt(master) == 0);
+	SerialPort port;
+	BOOST_REQUIRE(port.open(ptsname(master)));
+	BOOST_REQUIRE(port.configure(115200, false));
+	int pipe_fds[2];
+	BOOST_REQUIRE(pipe(pipe_fds) == 0);
+	LoopbackBenchmark benchmark;
+	benchmark
+		.setLatencySamples(2)
+		.setThroughputBytes(100)
+		.setTimeout(50);
+	LoopbackResult result;
+	// Nothing written to the pipe reaches the serial port.
+	BOOST_REQUIRE(benchmark.run(pipe_fds[1], port.getFd(), result));
+	BOOST_CHECK_EQUAL(result.latency_timeouts, 2u);
+	BOOST_CHECK_EQUAL(result.bytes_received, 0u);
+	BOOST_CHECK_EQUAL(result.errors, 100u);
+	BOOST_CHECK_CLOSE(result.getErrorRate(), 1.0, 0.001);
+	close(pipe_fds[0]);
+	close(pipe_fds[1]);
+	close(master);
+}
+BOOST_AUTO_TEST_SUITE_END()
+#endif
@@ -0,0 +1,95 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "poll_scheduler.h"
+#include <map>
+using namespace mcp2200;
+using namespace std;
+BOOST_AUTO_TEST_SUITE(poll_scheduler)
+BOOST_AUTO_TEST_CASE(budget_is_shared)
+{
+	PollScheduler scheduler(50);
+	for (int i = 0; i < 10; i++)
+		scheduler.add("/dev/hidraw" + to_string(i));
+	map<string, int> polls;
+	string key;
+	for (uint64_t now = 0; now < 2000000; now += 1000){
+		while (scheduler.next(now, key))
+			polls[key]++;
+	}
+	BOOST_CHECK_EQUAL(scheduler.getTransactions(), 100u);
+	BOOST_CHECK_EQUAL(polls.size(), 10u);
+	for (auto &poll: polls)
+		BOOST_CHECK_EQUAL(poll.second, 10);
+	BOOST_CHECK_EQUAL(scheduler.getDeviceInterval(), 200000u);
+}
+BOOST_AUTO_TEST_CASE(min_interval)
+{
+	PollScheduler scheduler(1000, 100000);
+	scheduler.add("a");
+	scheduler.add("b");
+	string key;
+	int count = 0;
+	for (uint64_t now = 0; now < 1000000; now += 1000){
+		while (scheduler.next(now, key))
+			count++;
+	}
+	BOOST_CHECK_EQUAL(count, 20);
+	BOOST_CHECK_EQUAL(scheduler.getDeviceInterval(), 100000u);
+}
+BOOST_AUTO_TEST_CASE(no_burst_after_idle)
+{
+	PollScheduler scheduler(10);
+	scheduler.add("a");
+	string key;
+	BOOST_CHECK(scheduler.next(0, key));
+	BOOST_CHECK(!scheduler.next(50000, key));
+	BOOST_CHECK(scheduler.next(5000000, key));
+	BOOST_CHECK(!scheduler.next(5000000, key));
+	BOOST_CHECK(scheduler.next(5100000, key));
+}
+BOOST_AUTO_TEST_CASE(add_remove)
+{
+	PollScheduler scheduler(1000);
+	BOOST_CHECK(scheduler.add("a"));
+	BOOST_CHECK(scheduler.add("b"));
+	BOOST_CHECK(!scheduler.add("a"));
+	BOOST_CHECK(scheduler.add("c"));
+	string key;
+	BOOST_CHECK(scheduler.next(0, key));
+	BOOST_CHECK_EQUAL(key, "a");
+	BOOST_CHECK(scheduler.next(1000, key));
+	BOOST_CHECK_EQUAL(key, "b");
+	BOOST_CHECK(scheduler.remove("a"));
+	BOOST_CHECK(!scheduler.remove("a"));
+	BOOST_CHECK(scheduler.next(2000, key));
+	BOOST_CHECK_EQUAL(key, "c");
+	BOOST_CHECK(scheduler.next(3000, key));
+	BOOST_CHECK_EQUAL(key, "b");
+	scheduler.clear();
+	BOOST_CHECK(!scheduler.next(10000, key));
+}
+BOOST_AUTO_TEST_SUITE_END()
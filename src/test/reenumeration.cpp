@@ -0,0 +1,54 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "reenumeration.h"
+using namespace mcp2200;
+using namespace std;
+BOOST_AUTO_TEST_SUITE(reenumeration)
+BOOST_AUTO_TEST_CASE(target_matches_serial_and_new_ids)
+{
+	Reenumeration reenumeration;
+	BOOST_CHECK(reenumeration.start("0000988086", 0x1234, 0x5678));
+	BOOST_CHECK(reenumeration.isTarget("0000988086", 0x1234, 0x5678));
+	BOOST_CHECK(!reenumeration.isTarget("0000988086", 0x04d8, 0x00df));
+	BOOST_CHECK(!reenumeration.isTarget("0000988123", 0x1234, 0x5678));
+	// Devices without serial number can only be matched by IDs.
+	BOOST_CHECK(reenumeration.start("", 0x1234, 0x5678));
+	BOOST_CHECK(reenumeration.isTarget("0000988123", 0x1234, 0x5678));
+}
+BOOST_AUTO_TEST_CASE(wait_times_out)
+{
+	Reenumeration reenumeration;
+	Device device;
+	BOOST_CHECK(reenumeration.start("0000988086", 0x1234, 0x5678));
+	auto start = chrono::steady_clock::now();
+	BOOST_CHECK(!reenumeration.wait(device, 50));
+	BOOST_CHECK(chrono::steady_clock::now() - start >= chrono::milliseconds(50));
+	BOOST_CHECK(!device.isOpen());
+	BOOST_CHECK_EQUAL(reenumeration.getLatency(), -1);
+	BOOST_CHECK(reenumeration.getPath().empty());
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,80 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "ring_buffer.h"
+#include <string>
+#ifdef LINUX_BUILD
+#include <unistd.h>
+#endif
+using namespace mcp2200;
+using namespace std;
+static string toString(const RingBuffer::Segments &segments)
+{
+	string result(reinterpret_cast<const char *>(segments.first), segments.first_size);
+	result.append(reinterpret_cast<const char *>(segments.second), segments.second_size);
+	return result;
+}
+BOOST_AUTO_TEST_SUITE(ring_buffer)
+BOOST_AUTO_TEST_CASE(capacity)
+{
+	RingBuffer buffer(100);
+	BOOST_CHECK_EQUAL(buffer.capacity(), 128u);
+	BOOST_CHECK(buffer.empty());
+	BOOST_CHECK_EQUAL(buffer.space(), 128u);
+}
+BOOST_AUTO_TEST_CASE(wraparound)
+{
+	RingBuffer buffer(8);
+	BOOST_CHECK_EQUAL(buffer.write(reinterpret_cast<const uint8_t *>("abcdef"), 6), 6u);
+	buffer.consume(4);
+	BOOST_CHECK_EQUAL(buffer.write(reinterpret_cast<const uint8_t *>("ghijklmn"), 8), 6u);
+	auto segments = buffer.peek();
+	BOOST_CHECK_EQUAL(segments.first_size, 4u);
+	BOOST_CHECK_EQUAL(segments.second_size, 4u);
+	BOOST_CHECK_EQUAL(toString(segments), "efghijkl");
+	BOOST_CHECK_EQUAL(buffer.space(), 0u);
+	buffer.consume(8);
+	BOOST_CHECK(buffer.empty());
+}
+#ifdef LINUX_BUILD
+BOOST_AUTO_TEST_CASE(read_from)
+{
+	int fds[2];
+	BOOST_REQUIRE(pipe(fds) == 0);
+	RingBuffer buffer(8);
+	buffer.write(reinterpret_cast<const uint8_t *>("xxxxxx"), 6);
+	buffer.consume(6);
+	BOOST_REQUIRE(write(fds[1], "0123456789", 10) == 10);
+	BOOST_CHECK_EQUAL(buffer.readFrom(fds[0]), 8);
+	BOOST_CHECK_EQUAL(toString(buffer.peek()), "01234567");
+	buffer.consume(8);
+	close(fds[1]);
+	BOOST_CHECK_EQUAL(buffer.readFrom(fds[0]), 2);
+	BOOST_CHECK_EQUAL(buffer.readFrom(fds[0]), 0);
+	close(fds[0]);
+}
+#endif
+BOOST_AUTO_TEST_SUITE_END()
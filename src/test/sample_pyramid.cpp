@@ -0,0 +1,114 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "sample_pyramid.h"
+#include <cstdlib>
+using namespace mcp2200;
+using namespace std;
+BOOST_AUTO_TEST_SUITE(sample_pyramid)
+BOOST_AUTO_TEST_CASE(query_matches_linear_scan)
+{
+	SamplePyramid pyramid;
+	vector<uint8_t> values;
+	srand(1);
+	for (int i = 0; i < 1000; i++){
+		uint8_t value = rand() & 0xff;
+		values.push_back(value);
+		pyramid.append(i * 10, value);
+	}
+	BOOST_CHECK_EQUAL(pyramid.getLevels(), 9u);
+	for (int i = 0; i < 2000; i++){
+		size_t begin = rand() % values.size();
+		size_t end = begin + rand() % (values.size() - begin) + 1;
+		uint8_t all = 0xff, any = 0;
+		for (size_t j = begin; j < end; j++){
+			all &= values[j];
+			any |= values[j];
+		}
+		auto span = pyramid.query(begin, end);
+		BOOST_CHECK(span.valid);
+		BOOST_CHECK_EQUAL(span.all, all);
+		BOOST_CHECK_EQUAL(span.any, any);
+	}
+	BOOST_CHECK(!pyramid.query(10, 10).valid);
+}
+BOOST_AUTO_TEST_CASE(render_preserves_short_pulses)
+{
+	SamplePyramid pyramid;
+	pyramid.append(0, 0x00);
+	for (uint64_t i = 0; i < 100000; i++){
+		pyramid.append(i * 100 + 10, 0x00);
+		// One microsecond pulse on pin 3 must stay visible at any zoom level.
+		if (i == 50000){
+			pyramid.append(i * 100 + 50, 0x08);
+			pyramid.append(i * 100 + 51, 0x00);
+		}
+	}
+	pyramid.extend(20000000);
+	vector<SamplePyramid::Span> spans;
+	pyramid.render(0, 20000000, 200, spans);
+	BOOST_REQUIRE_EQUAL(spans.size(), 200u);
+	for (size_t i = 0; i < spans.size(); i++){
+		BOOST_CHECK(spans[i].valid);
+		BOOST_CHECK_EQUAL(spans[i].getTransitions(), i == 50 ? 0x08 : 0x00);
+	}
+}
+BOOST_AUTO_TEST_CASE(render_holds_value_between_samples)
+{
+	SamplePyramid pyramid;
+	pyramid.append(100, 0x01);
+	pyramid.append(300, 0x03);
+	vector<SamplePyramid::Span> spans;
+	pyramid.render(0, 400, 4, spans);
+	BOOST_CHECK(!spans[0].valid);
+	BOOST_CHECK(spans[1].valid);
+	BOOST_CHECK_EQUAL(spans[1].all, 0x01);
+	BOOST_CHECK_EQUAL(spans[1].any, 0x01);
+	BOOST_CHECK_EQUAL(spans[2].all, 0x01);
+	BOOST_CHECK_EQUAL(spans[3].all, 0x03);
+	BOOST_CHECK_EQUAL(spans[3].getTransitions(), 0x00);
+	pyramid.extend(400);
+	pyramid.render(350, 550, 2, spans);
+	BOOST_CHECK(spans[0].valid);
+	BOOST_CHECK(!spans[1].valid);
+}
+BOOST_AUTO_TEST_CASE(append_records)
+{
+	SamplePyramid pyramid;
+	uint8_t data[] = {
+		0x10, 0x27, 0, 0, 0, 0, 0, 0, 0x05,
+		0x20, 0x4e, 0, 0, 0, 0, 0, 0, 0x06,
+		0x30, 0x75,
+	};
+	BOOST_CHECK_EQUAL(pyramid.appendRecords(data, sizeof(data)), 18u);
+	BOOST_REQUIRE_EQUAL(pyramid.size(), 2u);
+	BOOST_CHECK_EQUAL(pyramid.getTime(0), 10000u);
+	BOOST_CHECK_EQUAL(pyramid.getValue(1), 0x06);
+	BOOST_CHECK_EQUAL(pyramid.getEnd(), 20000u);
+	pyramid.append(15000, 0x07);
+	BOOST_CHECK_EQUAL(pyramid.getTime(2), 20000u);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,74 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "sample_writer.h"
+#include <string>
+using namespace command_line;
+using namespace std;
+BOOST_AUTO_TEST_SUITE(sample_writer)
+BOOST_AUTO_TEST_CASE(text)
+{
+	SampleWriter writer(SampleFormat::text);
+	writer.write(1500000, 0x83);
+	BOOST_CHECK_EQUAL(writer.getBuffer(), "1.500000 11000001\n");
+}
+BOOST_AUTO_TEST_CASE(csv)
+{
+	SampleWriter writer(SampleFormat::csv);
+	writer.write(10, 0x01);
+	writer.write(20, 0x80);
+	BOOST_CHECK_EQUAL(writer.getBuffer(),
+		"time_us,gpio0,gpio1,gpio2,gpio3,gpio4,gpio5,gpio6,gpio7\n"
+		"10,1,0,0,0,0,0,0,0\n"
+		"20,0,0,0,0,0,0,0,1\n");
+}
+BOOST_AUTO_TEST_CASE(ndjson)
+{
+	SampleWriter writer(SampleFormat::ndjson);
+	writer.write(42, 0x05);
+	BOOST_CHECK_EQUAL(writer.getBuffer(), "{\"time_us\":42,\"gpio\":5,\"bits\":\"10100000\"}\n");
+}
+BOOST_AUTO_TEST_CASE(binary)
+{
+	SampleWriter writer(SampleFormat::binary);
+	writer.write(0x0102030405060708ull, 0xa5);
+	const string &buffer = writer.getBuffer();
+	BOOST_REQUIRE_EQUAL(buffer.size(), SampleWriter::binary_record_size);
+	BOOST_CHECK_EQUAL(static_cast<uint8_t>(buffer[0]), 0x08);
+	BOOST_CHECK_EQUAL(static_cast<uint8_t>(buffer[7]), 0x01);
+	BOOST_CHECK_EQUAL(static_cast<uint8_t>(buffer[8]), 0xa5);
+}
+BOOST_AUTO_TEST_CASE(capacity)
+{
+	SampleWriter writer(SampleFormat::binary, SampleWriter::binary_record_size * 2);
+	writer.write(1, 0);
+	BOOST_CHECK(!writer.isFull());
+	writer.write(2, 0);
+	BOOST_CHECK(writer.isFull());
+	writer.clear();
+	BOOST_CHECK(writer.isEmpty());
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,102 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef LINUX_BUILD
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "serial_index.h"
+#include <unistd.h>
+#include <sys/stat.h>
+#include <cstdio>
+using namespace mcp2200;
+using namespace std;
+static string indexFilename()
+{
+	char filename[] = "/tmp/mcp2200-index-XXXXXX";
+	int fd = mkstemp(filename);
+	close(fd);
+	return filename;
+}
+BOOST_AUTO_TEST_SUITE(serial_index)
+BOOST_AUTO_TEST_CASE(update_lookup_and_remove)
+{
+	auto filename = indexFilename();
+	SerialIndex index;
+	BOOST_REQUIRE(index.open(filename));
+	string path;
+	BOOST_CHECK(!index.lookup(0x04d8, 0x00df, "0000988086", path));
+	BOOST_CHECK(index.update(0x04d8, 0x00df, "0000988086", "/dev/hidraw3"));
+	BOOST_CHECK(index.lookup(0x04d8, 0x00df, "0000988086", path));
+	BOOST_CHECK_EQUAL(path, "/dev/hidraw3");
+	BOOST_CHECK(!index.lookup(0x04d8, 0x00de, "0000988086", path));
+	// Another device reusing the same path replaces the old entry.
+	BOOST_CHECK(index.update(0x04d8, 0x00df, "0000988123", "/dev/hidraw3"));
+	BOOST_CHECK(!index.lookup(0x04d8, 0x00df, "0000988086", path));
+	BOOST_CHECK_EQUAL(index.size(), 1u);
+	BOOST_CHECK(index.remove("/dev/hidraw3"));
+	BOOST_CHECK(!index.lookup(0x04d8, 0x00df, "0000988123", path));
+	BOOST_CHECK(!index.update(0x04d8, 0x00df, string(100, 'x'), "/dev/hidraw3"));
+	unlink(filename.c_str());
+}
+BOOST_AUTO_TEST_CASE(index_is_shared_and_persistent)
+{
+	auto filename = indexFilename();
+	SerialIndex first, second;
+	BOOST_REQUIRE(first.open(filename));
+	BOOST_REQUIRE(second.open(filename));
+	first.replace(0x04d8, 0x00df, {
+		DeviceInformation("/dev/hidraw3", "0000988086", "", "", 0),
+		DeviceInformation("/dev/hidraw5", "0000988123", "", "", 0),
+	});
+	string path;
+	BOOST_CHECK(second.lookup(0x04d8, 0x00df, "0000988123", path));
+	BOOST_CHECK_EQUAL(path, "/dev/hidraw5");
+	first.close();
+	second.close();
+	SerialIndex reopened;
+	BOOST_REQUIRE(reopened.open(filename));
+	BOOST_CHECK_EQUAL(reopened.size(), 2u);
+	reopened.replace(0x04d8, 0x00df, {DeviceInformation("/dev/hidraw4", "0000988086", "", "", 0)});
+	BOOST_CHECK(reopened.lookup(0x04d8, 0x00df, "0000988086", path));
+	BOOST_CHECK_EQUAL(path, "/dev/hidraw4");
+	BOOST_CHECK(!reopened.lookup(0x04d8, 0x00df, "0000988123", path));
+	unlink(filename.c_str());
+}
+BOOST_AUTO_TEST_CASE(refuses_unsafe_files)
+{
+	auto filename = indexFilename();
+	auto link = filename + "-link";
+	BOOST_REQUIRE(symlink(filename.c_str(), link.c_str()) == 0);
+	SerialIndex index;
+	BOOST_CHECK(!index.open(link));
+	BOOST_CHECK(!index.isOpen());
+	chmod(filename.c_str(), 0644);
+	BOOST_CHECK(!index.open(filename));
+	chmod(filename.c_str(), 0600);
+	BOOST_CHECK(index.open(filename));
+	unlink(link.c_str());
+	unlink(filename.c_str());
+}
+BOOST_AUTO_TEST_SUITE_END()
+#endif
@@ -0,0 +1,174 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef LINUX_BUILD
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "serial_port.h"
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <termios.h>
+using namespace mcp2200;
+using namespace std;
+namespace fs = std::filesystem;
+struct PseudoTerminal
+{
+	int master;
+	string slave_path;
+	PseudoTerminal()
+	{
+		master = posix_openpt(O_RDWR | O_NOCTTY);
+		BOOST_REQUIRE(master >= 0);
+		BOOST_REQUIRE(grantpt(master) == 0 && unlockpt(master) == 0);
+		slave_path = ptsname(master);
+	}
+	~PseudoTerminal()
+	{
+		close(master);
+	}
+	string readMaster(size_t size)
+	{
+		string result;
+		char buffer[256];
+		while (result.size() < size){
+			ssize_t count = read(master, buffer, sizeof(buffer));
+			if (count <= 0) break;
+			result.append(buffer, count);
+		}
+		return result;
+	}
+};
+BOOST_AUTO_TEST_SUITE(serial_port)
+BOOST_AUTO_TEST_CASE(standard_baud_rate)
+{
+	BOOST_CHECK_EQUAL(SerialPort::toStandardBaudRate(9600), 9600);
+	BOOST_CHECK_EQUAL(SerialPort::toStandardBaudRate(12000000 / (103 + 1)), 115200);
+	BOOST_CHECK_EQUAL(SerialPort::toStandardBaudRate(12000000 / (1 + 1)), 0);
+}
+BOOST_AUTO_TEST_CASE(configure)
+{
+	PseudoTerminal pty;
+	SerialPort port;
+	BOOST_REQUIRE(port.open(pty.slave_path));
+	BOOST_CHECK(port.configure(12000000 / (103 + 1), false));
+	termios options;
+	BOOST_REQUIRE(tcgetattr(port.getFd(), &options) == 0);
+	BOOST_CHECK_EQUAL(cfgetospeed(&options), static_cast<speed_t>(B115200));
+	BOOST_CHECK((options.c_lflag & ICANON) == 0);
+	BOOST_CHECK(!port.configure(12000000 / (1 + 1), false));
+}
+BOOST_AUTO_TEST_CASE(send)
+{
+	PseudoTerminal pty;
+	SerialPort port;
+	BOOST_REQUIRE(port.open(pty.slave_path));
+	BOOST_REQUIRE(port.configure(9600, false));
+	int pipe_fds[2];
+	BOOST_REQUIRE(pipe(pipe_fds) == 0);
+	string data(1000, 'x');
+	BOOST_REQUIRE(write(pipe_fds[1], data.data(), data.size()) == static_cast<ssize_t>(data.size()));
+	close(pipe_fds[1]);
+	StreamPump pump(pipe_fds[0], port.getFd());
+	while (!pump.isFinished()){
+		BOOST_REQUIRE(pump.transfer() >= 0);
+	}
+	close(pipe_fds[0]);
+	BOOST_CHECK_EQUAL(pump.getBytes(), data.size());
+	BOOST_CHECK_EQUAL(pty.readMaster(data.size()), data);
+}
+BOOST_AUTO_TEST_CASE(send_does_not_block)
+{
+	PseudoTerminal pty;
+	SerialPort port;
+	BOOST_REQUIRE(port.open(pty.slave_path));
+	BOOST_REQUIRE(port.configure(9600, false));
+	BOOST_REQUIRE(port.setNonBlocking(true));
+	char file_template[] = "/tmp/mcp2200-test-XXXXXX";
+	int file = mkstemp(file_template);
+	BOOST_REQUIRE(file >= 0);
+	unlink(file_template);
+	// More than the tty buffer holds, so the pump has to stop and wait for the other side.
+	string data(512 * 1024, 'x');
+	BOOST_REQUIRE(write(file, data.data(), data.size()) == static_cast<ssize_t>(data.size()));
+	BOOST_REQUIRE(lseek(file, 0, SEEK_SET) == 0);
+	StreamPump pump(file, port.getFd());
+	string result;
+	bool blocked = false;
+	while (!pump.isFinished()){
+		BOOST_REQUIRE(pump.transfer() >= 0);
+		if (pump.isBlocked()){
+			blocked = true;
+			result += pty.readMaster(1024);
+		}
+	}
+	close(file);
+	result += pty.readMaster(data.size() - result.size());
+	BOOST_CHECK(blocked);
+	BOOST_CHECK_EQUAL(pump.getBytes(), data.size());
+	BOOST_CHECK(result == data);
+}
+BOOST_AUTO_TEST_CASE(receive)
+{
+	PseudoTerminal pty;
+	SerialPort port;
+	BOOST_REQUIRE(port.open(pty.slave_path));
+	BOOST_REQUIRE(port.configure(9600, false));
+	string data = "received data";
+	BOOST_REQUIRE(write(pty.master, data.data(), data.size()) == static_cast<ssize_t>(data.size()));
+	char file_template[] = "/tmp/mcp2200-test-XXXXXX";
+	int file = mkstemp(file_template);
+	BOOST_REQUIRE(file >= 0);
+	StreamPump pump(port.getFd(), file);
+	while (pump.getBytes() < data.size()){
+		BOOST_REQUIRE(pump.transfer() > 0);
+	}
+	close(file);
+	ifstream input(file_template);
+	string result((istreambuf_iterator<char>(input)), istreambuf_iterator<char>());
+	unlink(file_template);
+	BOOST_CHECK_EQUAL(result, data);
+}
+BOOST_AUTO_TEST_CASE(find_path)
+{
+	auto root = fs::temp_directory_path() / ("mcp2200-sysfs-" + to_string(getpid()));
+	auto usb_device = root / "devices" / "pci0000:00" / "usb1" / "1-2";
+	auto hid_device = usb_device / "1-2:1.2" / "0003:04D8:00DF.0003";
+	fs::create_directories(hid_device / "hidraw" / "hidraw3");
+	fs::create_directories(usb_device / "1-2:1.0" / "tty" / "ttyACM0");
+	fs::create_directories(usb_device / "1-2:1.1");
+	fs::create_directories(root / "class" / "hidraw");
+	fs::create_directory_symlink(hid_device / "hidraw" / "hidraw3", root / "class" / "hidraw" / "hidraw3");
+	fs::create_directory_symlink(hid_device, hid_device / "hidraw" / "hidraw3" / "device");
+	string tty_path;
+	BOOST_CHECK(SerialPort::findPath("/dev/hidraw3", tty_path, root.string()));
+	BOOST_CHECK_EQUAL(tty_path, "/dev/ttyACM0");
+	BOOST_CHECK(!SerialPort::findPath("/dev/hidraw4", tty_path, root.string()));
+	fs::remove_all(root);
+}
+BOOST_AUTO_TEST_SUITE_END()
+#endif
@@ -0,0 +1,149 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "session.h"
+#include <vector>
+using namespace mcp2200;
+using namespace std;
+BOOST_AUTO_TEST_SUITE(session)
+BOOST_AUTO_TEST_CASE(closed_session_does_not_open_any_device)
+{
+	Session session;
+	BOOST_CHECK(!session.isConnected());
+	BOOST_CHECK(!session.reconnect(0));
+	BOOST_CHECK(!session.setGpioValues(0x55));
+	Command response;
+	BOOST_CHECK(!session.readAll(response));
+	BOOST_CHECK(!session.attach(0x04d8, 0x00df));
+	BOOST_CHECK(session.getOutages().empty());
+}
+BOOST_AUTO_TEST_CASE(missing_device_is_not_an_outage)
+{
+	Session session;
+	BOOST_CHECK(!session.open(0x1234, 0x5678, "0000988086"));
+	BOOST_CHECK_EQUAL(session.getSerial(), "0000988086");
+	auto start = chrono::steady_clock::now();
+	session.setReconnectTimeout(30);
+	BOOST_CHECK(!session.setGpioValues(0x55));
+	BOOST_CHECK(chrono::steady_clock::now() - start >= chrono::milliseconds(30));
+	session.notifyRemoved("/dev/hidraw3");
+	BOOST_CHECK(!session.isConnected());
+	BOOST_CHECK(session.getOutages().empty());
+}
+// Device which can be unplugged, it remembers every command written while present.
+struct FakeDevice: public Transport
+{
+	vector<Command> written;
+	bool present;
+	FakeDevice():
+		present(true)
+	{
+	}
+	virtual bool write(const Command &command)
+	{
+		if (!present) return false;
+		written.push_back(command);
+		return true;
+	}
+	virtual bool read(Command &response, int)
+	{
+		if (!present) return false;
+		response = Command();
+		response.setCommand(CommandType::read_all);
+		return true;
+	}
+};
+BOOST_AUTO_TEST_CASE(reconnect_replays_state)
+{
+	FakeDevice fake;
+	int attempts = 0;
+	Session session;
+	session.setOpener([&fake, &attempts](Device &device, string &path){
+		// Device comes back on the third attempt after being unplugged.
+		if (!fake.present && ++attempts < 3) return false;
+		fake.present = true;
+		path = "/dev/hidraw7";
+		return device.open(fake);
+	});
+	session.setReconnectTimeout(1000);
+	BOOST_REQUIRE(session.open(0x04d8, 0x00df, "0000988086"));
+	BOOST_CHECK_EQUAL(session.getPath(), "/dev/hidraw7");
+	Command configuration;
+	configuration
+		.setCommand(CommandType::configure)
+		.setIoDirections(0x0f)
+		;
+	BOOST_REQUIRE(session.write(configuration));
+	BOOST_REQUIRE(session.setGpioValues(0x05));
+	fake.present = false;
+	fake.written.clear();
+	BOOST_CHECK(session.setGpioValues(0x0a));
+	BOOST_CHECK(session.isConnected());
+	BOOST_REQUIRE_EQUAL(fake.written.size(), 3u);
+	BOOST_CHECK_EQUAL(fake.written[0].command_type, static_cast<uint8_t>(CommandType::configure));
+	BOOST_CHECK(fake.written[0].data == configuration.data);
+	BOOST_CHECK_EQUAL(fake.written[1].command_type, static_cast<uint8_t>(CommandType::set_clear_outputs));
+	// Failed write is recorded before it is retried, so replay already restores the new outputs.
+	BOOST_CHECK_EQUAL(fake.written[1].set_clear_outputs.set, 0x0a);
+	BOOST_CHECK_EQUAL(fake.written[2].command_type, static_cast<uint8_t>(CommandType::set_clear_outputs));
+	BOOST_CHECK_EQUAL(fake.written[2].set_clear_outputs.set, 0x0a);
+	BOOST_REQUIRE_EQUAL(session.getOutages().size(), 1u);
+	BOOST_CHECK_EQUAL(session.getOutages()[0].reason, "write failed");
+	BOOST_CHECK(session.getOutages()[0].downtime_us >= 10000);
+	// Only removal of the connected path is an outage.
+	session.notifyRemoved("/dev/hidraw8");
+	BOOST_CHECK(session.isConnected());
+	session.notifyRemoved("/dev/hidraw7");
+	BOOST_CHECK(!session.isConnected());
+	BOOST_REQUIRE_EQUAL(session.getOutages().size(), 2u);
+	BOOST_CHECK_EQUAL(session.getOutages()[1].reason, "device removed");
+	BOOST_CHECK_EQUAL(session.getOutages()[1].downtime_us, -1);
+	fake.written.clear();
+	Command response;
+	BOOST_CHECK(session.readAll(response));
+	BOOST_CHECK(session.getOutages()[1].downtime_us >= 0);
+	BOOST_REQUIRE_EQUAL(fake.written.size(), 3u);
+	BOOST_CHECK_EQUAL(fake.written[1].set_clear_outputs.set, 0x0a);
+	BOOST_CHECK_EQUAL(fake.written[2].command_type, static_cast<uint8_t>(CommandType::read_all));
+}
+BOOST_AUTO_TEST_CASE(reconnect_gives_up_after_timeout)
+{
+	FakeDevice fake;
+	Session session;
+	session.setOpener([&fake](Device &device, string &path){
+		if (!fake.present) return false;
+		path = "/dev/hidraw7";
+		return device.open(fake);
+	});
+	session.setReconnectTimeout(20);
+	BOOST_REQUIRE(session.open(0x04d8, 0x00df, "0000988086"));
+	fake.present = false;
+	BOOST_CHECK(!session.setGpioValues(0x0a));
+	BOOST_CHECK(!session.isConnected());
+	BOOST_REQUIRE_EQUAL(session.getOutages().size(), 1u);
+	BOOST_CHECK_EQUAL(session.getOutages()[0].downtime_us, -1);
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef LINUX_BUILD
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "sysfs_enumerator.h"
+#include <unistd.h>
+#include <filesystem>
+#include <fstream>
+using namespace mcp2200;
+using namespace std;
+namespace fs = std::filesystem;
+static void addDevice(const fs::path &root, const string &port, const string &hid_name, const string &hidraw, const string &serial)
+{
+	auto usb_device = root / "devices" / "pci0000:00" / "usb1" / port;
+	auto hid_device = usb_device / (port + ":1.2") / hid_name;
+	fs::create_directories(hid_device / "hidraw" / hidraw);
+	fs::create_directories(root / "class" / "hidraw");
+	fs::create_directory_symlink(hid_device / "hidraw" / hidraw, root / "class" / "hidraw" / hidraw);
+	fs::create_directory_symlink(hid_device, hid_device / "hidraw" / hidraw / "device");
+	ofstream(usb_device / "serial") << serial << "\n";
+	ofstream(usb_device / "manufacturer") << "Microchip Technology Inc.\n";
+	ofstream(usb_device / "product") << "MCP2200 USB Serial Port Emulator\n";
+	ofstream(usb_device / "bcdDevice") << "0101\n";
+}
+BOOST_AUTO_TEST_SUITE(sysfs_enumerator)
+BOOST_AUTO_TEST_CASE(parse_hid_name)
+{
+	uint16_t vendor_id, product_id;
+	BOOST_CHECK(SysfsEnumerator::parseHidName("0003:04D8:00DF.0003", vendor_id, product_id));
+	BOOST_CHECK_EQUAL(vendor_id, 0x04d8);
+	BOOST_CHECK_EQUAL(product_id, 0x00df);
+	BOOST_CHECK(!SysfsEnumerator::parseHidName("0005:04D8:00DF.0003", vendor_id, product_id));
+	BOOST_CHECK(!SysfsEnumerator::parseHidName("0003:04D8", vendor_id, product_id));
+	BOOST_CHECK(!SysfsEnumerator::parseHidName("0003:04X8:00DF.0003", vendor_id, product_id));
+}
+BOOST_AUTO_TEST_CASE(find_filters_by_ids)
+{
+	auto root = fs::temp_directory_path() / ("mcp2200-enumerate-" + to_string(getpid()));
+	addDevice(root, "1-2", "0003:04D8:00DF.0003", "hidraw10", "0000988086");
+	addDevice(root, "1-3", "0003:046D:C52B.0001", "hidraw0", "keyboard");
+	addDevice(root, "1-4", "0003:04D8:00DF.0004", "hidraw9", "0000988123");
+	SysfsEnumerator enumerator(root.string());
+	vector<DeviceInformation> devices;
+	BOOST_CHECK(enumerator.find(0x04d8, 0x00df, devices));
+	BOOST_REQUIRE_EQUAL(devices.size(), 2u);
+	BOOST_CHECK_EQUAL(devices[0].path, "/dev/hidraw9");
+	BOOST_CHECK_EQUAL(devices[0].serial, "0000988123");
+	BOOST_CHECK_EQUAL(devices[1].path, "/dev/hidraw10");
+	BOOST_CHECK_EQUAL(devices[1].serial, "0000988086");
+	BOOST_CHECK_EQUAL(devices[1].manufacturer, "Microchip Technology Inc.");
+	BOOST_CHECK_EQUAL(devices[1].product, "MCP2200 USB Serial Port Emulator");
+	BOOST_CHECK_EQUAL(devices[1].release_number, 0x0101);
+	BOOST_CHECK(enumerator.find(0, 0, devices));
+	BOOST_CHECK_EQUAL(devices.size(), 3u);
+	uint16_t vendor_id, product_id;
+	BOOST_CHECK(enumerator.getIds("/dev/hidraw0", vendor_id, product_id));
+	BOOST_CHECK_EQUAL(vendor_id, 0x046d);
+	BOOST_CHECK_EQUAL(product_id, 0xc52b);
+	BOOST_CHECK(!enumerator.getIds("/dev/hidraw1", vendor_id, product_id));
+	fs::remove_all(root);
+	BOOST_CHECK(!enumerator.find(0x04d8, 0x00df, devices));
+	BOOST_CHECK(devices.empty());
+}
+BOOST_AUTO_TEST_SUITE_END()
+#endif
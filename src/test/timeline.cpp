@@ -0,0 +1,85 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "timeline.h"
+#include <string>
+using namespace command_line;
+using namespace std;
+BOOST_AUTO_TEST_SUITE(timeline)
+BOOST_AUTO_TEST_CASE(merge_waits_for_both_sources)
+{
+	Timeline timeline(SampleFormat::text);
+	string output;
+	timeline.addUart(1000, reinterpret_cast<const uint8_t *>("AB"), 2);
+	timeline.addUart(3000, reinterpret_cast<const uint8_t *>("C"), 1);
+	BOOST_CHECK_EQUAL(timeline.merge(output), 0u);
+	timeline.addGpio(2000, 0x01);
+	timeline.advance(TimelineSource::gpio, 2500);
+	BOOST_CHECK_EQUAL(timeline.merge(output), 2u);
+	BOOST_CHECK_EQUAL(output, "0.001000 uart 4142\n0.002000 gpio 10000000\n");
+	output.clear();
+	timeline.addGpio(2800, 0x03);
+	BOOST_CHECK_EQUAL(timeline.getPending(), 2u);
+	BOOST_CHECK_EQUAL(timeline.finish(output), 2u);
+	BOOST_CHECK_EQUAL(output, "0.002800 gpio 11000000\n0.003000 uart 43\n");
+	BOOST_CHECK_EQUAL(timeline.getPending(), 0u);
+}
+BOOST_AUTO_TEST_CASE(formats)
+{
+	Timeline csv(SampleFormat::csv);
+	string output;
+	csv.addGpio(5, 0x80);
+	csv.addUart(7, reinterpret_cast<const uint8_t *>("\x0a"), 1);
+	csv.finish(output);
+	BOOST_CHECK_EQUAL(output, "time_us,source,data\n5,gpio,00000001\n7,uart,0a\n");
+	Timeline ndjson(SampleFormat::ndjson);
+	output.clear();
+	ndjson.addGpio(5, 0x80);
+	ndjson.addUart(7, reinterpret_cast<const uint8_t *>("\x0a"), 1);
+	ndjson.finish(output);
+	BOOST_CHECK_EQUAL(output, "{\"time_us\":5,\"gpio\":128,\"bits\":\"00000001\"}\n{\"time_us\":7,\"uart\":\"0a\"}\n");
+	Timeline binary(SampleFormat::binary);
+	output.clear();
+	binary.addUart(1, reinterpret_cast<const uint8_t *>("z"), 1);
+	binary.finish(output);
+	BOOST_CHECK_EQUAL(output, string("\x01\0\0\0\0\0\0\0\x01\x01\0\0\0z", 14));
+}
+BOOST_AUTO_TEST_CASE(long_capture)
+{
+	Timeline timeline(SampleFormat::csv);
+	string output;
+	size_t merged = 0;
+	for (uint64_t time = 0; time < 100000; time += 2){
+		timeline.addGpio(time, static_cast<uint8_t>(time));
+		timeline.addUart(time + 1, reinterpret_cast<const uint8_t *>("x"), 1);
+		merged += timeline.merge(output);
+		output.clear();
+	}
+	merged += timeline.finish(output);
+	BOOST_CHECK_EQUAL(merged, 100000u);
+	BOOST_CHECK_EQUAL(timeline.getPending(), 0u);
+}
+BOOST_AUTO_TEST_SUITE_END()
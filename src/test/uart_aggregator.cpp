@@ -0,0 +1,108 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef LINUX_BUILD
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "uart_aggregator.h"
+#include <string>
+#include <unistd.h>
+#include <fcntl.h>
+using namespace command_line;
+using namespace std;
+struct Pipe
+{
+	int fds[2];
+	Pipe()
+	{
+		BOOST_REQUIRE(pipe2(fds, O_CLOEXEC) == 0);
+	}
+	~Pipe()
+	{
+		if (fds[0] >= 0) close(fds[0]);
+		if (fds[1] >= 0) close(fds[1]);
+	}
+	void closeWrite()
+	{
+		close(fds[1]);
+		fds[1] = -1;
+	}
+	string readAll()
+	{
+		string result;
+		char buffer[256];
+		ssize_t count;
+		while ((count = read(fds[0], buffer, sizeof(buffer))) > 0)
+			result.append(buffer, count);
+		return result;
+	}
+};
+BOOST_AUTO_TEST_SUITE(uart_aggregator)
+BOOST_AUTO_TEST_CASE(record_formats)
+{
+	const uint8_t data[] = {0x01, 0xab, 0x10};
+	mcp2200::RingBuffer::Segments segments = {data, data + 2, 2, 1};
+	string output;
+	UartAggregator::appendRecord(output, SampleFormat::text, 1500000, 2, segments);
+	BOOST_CHECK_EQUAL(output, "1.500000 2 01ab10\n");
+	output.clear();
+	UartAggregator::appendRecord(output, SampleFormat::csv, 1500000, 2, segments);
+	BOOST_CHECK_EQUAL(output, "1500000,2,01ab10\n");
+	output.clear();
+	UartAggregator::appendRecord(output, SampleFormat::ndjson, 1500000, 2, segments);
+	BOOST_CHECK_EQUAL(output, "{\"time_us\":1500000,\"port\":2,\"data\":\"01ab10\"}\n");
+	output.clear();
+	UartAggregator::appendRecord(output, SampleFormat::binary, 1, 2, segments);
+	BOOST_CHECK_EQUAL(output, string("\x01\0\0\0\0\0\0\0\x02\0\x03\0\0\0\x01\xab\x10", 17));
+}
+BOOST_AUTO_TEST_CASE(merge_ports)
+{
+	Pipe first, second, output;
+	UartAggregator aggregator(output.fds[1], SampleFormat::csv);
+	aggregator.setFlushInterval(chrono::microseconds(0));
+	BOOST_REQUIRE(aggregator.open());
+	BOOST_REQUIRE(aggregator.addPort(first.fds[0], "first"));
+	BOOST_REQUIRE(aggregator.addPort(second.fds[0], "second"));
+	BOOST_REQUIRE(write(first.fds[1], "ab", 2) == 2);
+	BOOST_REQUIRE(write(second.fds[1], "c", 1) == 1);
+	first.closeWrite();
+	second.closeWrite();
+	for (int i = 0; i < 10 && aggregator.getOpenPorts() > 0; i++){
+		BOOST_REQUIRE(aggregator.poll(100));
+	}
+	BOOST_CHECK_EQUAL(aggregator.getOpenPorts(), 0u);
+	BOOST_REQUIRE(aggregator.flush());
+	output.closeWrite();
+	string records = output.readAll();
+	BOOST_CHECK_EQUAL(records.substr(0, 18), "time_us,port,data\n");
+	BOOST_CHECK(records.find(",0,6162\n") != string::npos);
+	BOOST_CHECK(records.find(",1,63\n") != string::npos);
+	BOOST_CHECK_EQUAL(aggregator.getStatistics(0).bytes, 2u);
+	BOOST_CHECK_EQUAL(aggregator.getStatistics(1).bytes, 1u);
+	BOOST_CHECK_EQUAL(aggregator.getStatistics(1).name, "second");
+	BOOST_CHECK(!aggregator.getStatistics(0).open);
+	BOOST_CHECK_EQUAL(aggregator.getBytesWritten(), records.size());
+}
+BOOST_AUTO_TEST_SUITE_END()
+#endif
@@ -0,0 +1,102 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "worker.h"
+#include <atomic>
+#include <future>
+#include <vector>
+using namespace mcp2200;
+using namespace std;
+BOOST_AUTO_TEST_SUITE(worker)
+BOOST_AUTO_TEST_CASE(jobs_run_in_order_on_worker_thread)
+{
+	Worker worker;
+	worker.start();
+	vector<int> order;
+	atomic<bool> on_worker(true);
+	promise<void> done;
+	for (int i = 0; i < 100; i++){
+		worker.post([&order, &on_worker, &worker, i]{
+			order.push_back(i);
+			if (!worker.isWorkerThread()) on_worker = false;
+		});
+	}
+	worker.post([&done]{ done.set_value(); });
+	done.get_future().wait();
+	worker.stop();
+	BOOST_CHECK(on_worker);
+	BOOST_REQUIRE_EQUAL(order.size(), 100u);
+	for (int i = 0; i < 100; i++)
+		BOOST_CHECK_EQUAL(order[i], i);
+	BOOST_CHECK(!worker.post([]{}));
+	BOOST_CHECK_EQUAL(worker.getPending(), 0u);
+}
+BOOST_AUTO_TEST_CASE(stop_drops_pending_jobs)
+{
+	Worker worker;
+	promise<void> started, release;
+	auto release_future = release.get_future().share();
+	atomic<int> executed(0);
+	worker.start();
+	worker.post([&started, release_future, &executed]{
+		started.set_value();
+		release_future.wait();
+		executed++;
+	});
+	worker.post([&executed]{ executed++; });
+	started.get_future().wait();
+	BOOST_CHECK_EQUAL(worker.getPending(), 2u);
+	thread stopper([&worker]{ worker.stop(); });
+	while (worker.getPending() != 1)
+		this_thread::sleep_for(chrono::milliseconds(1));
+	release.set_value();
+	stopper.join();
+	BOOST_CHECK_EQUAL(executed, 1);
+}
+BOOST_AUTO_TEST_CASE(jobs_run_concurrently_on_several_threads)
+{
+	Worker worker;
+	worker.start(4);
+	promise<void> release;
+	auto release_future = release.get_future().share();
+	atomic<int> started(0), on_worker(0);
+	for (int i = 0; i < 4; i++){
+		worker.post([&started, &on_worker, &worker, release_future]{
+			if (worker.isWorkerThread()) on_worker++;
+			started++;
+			release_future.wait();
+		});
+	}
+	// All four jobs block until released, so they can only all start when they run in parallel.
+	while (started != 4)
+		this_thread::sleep_for(chrono::milliseconds(1));
+	BOOST_CHECK_EQUAL(worker.getPending(), 4u);
+	release.set_value();
+	worker.stop();
+	BOOST_CHECK_EQUAL(on_worker, 4);
+	BOOST_CHECK(!worker.isWorkerThread());
+}
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,170 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "timeline.h"
+#include "helpers.h"
+#include <cstdio>
+#include <limits>
+#include <algorithm>
+#include <boost/endian/conversion.hpp>
+using namespace std;
+namespace command_line
+{
+	Timeline::Queue::Queue():
+		next(0),
+		watermark(0)
+	{
+	}
+	bool Timeline::Queue::hasEvent(uint64_t limit) const
+	{
+		return next < events.size() && events[next].time_us <= limit;
+	}
+	void Timeline::Queue::compact()
+	{
+		// Consumed events are dropped in blocks, so merging stays linear in the number of events.
+		if (next == 0 || next * 2 < events.size()) return;
+		size_t data_offset = next < events.size() ? events[next].offset : data.size();
+		events.erase(events.begin(), events.begin() + next);
+		for (auto &event: events)
+			event.offset -= static_cast<uint32_t>(data_offset);
+		data.erase(0, data_offset);
+		next = 0;
+	}
+	Timeline::Timeline(SampleFormat format):
+		m_format(format),
+		m_header(format == SampleFormat::csv)
+	{
+	}
+	void Timeline::addGpio(uint64_t time_us, uint8_t value)
+	{
+		m_gpio.events.push_back(Event{time_us, static_cast<uint32_t>(m_gpio.data.size()), 1});
+		m_gpio.data += static_cast<char>(value);
+		m_gpio.watermark = max(m_gpio.watermark, time_us);
+	}
+	void Timeline::addUart(uint64_t time_us, const uint8_t *data, size_t size)
+	{
+		m_uart.events.push_back(Event{time_us, static_cast<uint32_t>(m_uart.data.size()), static_cast<uint32_t>(size)});
+		m_uart.data.append(reinterpret_cast<const char *>(data), size);
+		m_uart.watermark = max(m_uart.watermark, time_us);
+	}
+	void Timeline::advance(TimelineSource source, uint64_t time_us)
+	{
+		auto &queue = source == TimelineSource::gpio ? m_gpio : m_uart;
+		queue.watermark = max(queue.watermark, time_us);
+	}
+	size_t Timeline::merge(string &output)
+	{
+		// Events later than the oldest source watermark could still be preceded by events not received yet.
+		return merge(output, min(m_gpio.watermark, m_uart.watermark));
+	}
+	size_t Timeline::finish(string &output)
+	{
+		return merge(output, numeric_limits<uint64_t>::max());
+	}
+	size_t Timeline::getPending() const
+	{
+		return (m_gpio.events.size() - m_gpio.next) + (m_uart.events.size() - m_uart.next);
+	}
+	size_t Timeline::merge(string &output, uint64_t limit)
+	{
+		if (m_header){
+			output += "time_us,source,data\n";
+			m_header = false;
+		}
+		size_t count = 0;
+		for (;;){
+			bool gpio = m_gpio.hasEvent(limit), uart = m_uart.hasEvent(limit);
+			if (gpio && uart){
+				if (m_uart.events[m_uart.next].time_us < m_gpio.events[m_gpio.next].time_us)
+					gpio = false;
+				else
+					uart = false;
+			}
+			if (gpio){
+				append(output, TimelineSource::gpio, m_gpio.events[m_gpio.next++], m_gpio.data);
+			}else if (uart){
+				append(output, TimelineSource::uart, m_uart.events[m_uart.next++], m_uart.data);
+			}else{
+				break;
+			}
+			count++;
+		}
+		m_gpio.compact();
+		m_uart.compact();
+		return count;
+	}
+	static void appendBits(string &output, uint8_t value)
+	{
+		for (int i = 0; i < 8; i++)
+			output += ((value >> i) & 1) ? '1' : '0';
+	}
+	void Timeline::append(string &output, TimelineSource source, const Event &event, const string &data)
+	{
+		const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data.data()) + event.offset;
+		bool gpio = source == TimelineSource::gpio;
+		char number[48];
+		switch (m_format){
+			case SampleFormat::text:
+				snprintf(number, sizeof(number), "%llu.%06llu %s ", static_cast<unsigned long long>(event.time_us / 1000000), static_cast<unsigned long long>(event.time_us % 1000000), gpio ? "gpio" : "uart");
+				output += number;
+				if (gpio)
+					appendBits(output, bytes[0]);
+				else
+					appendHex(output, bytes, event.size);
+				output += '\n';
+				break;
+			case SampleFormat::csv:
+				snprintf(number, sizeof(number), "%llu,%s,", static_cast<unsigned long long>(event.time_us), gpio ? "gpio" : "uart");
+				output += number;
+				if (gpio)
+					appendBits(output, bytes[0]);
+				else
+					appendHex(output, bytes, event.size);
+				output += '\n';
+				break;
+			case SampleFormat::ndjson:
+				if (gpio){
+					snprintf(number, sizeof(number), "{\"time_us\":%llu,\"gpio\":%u,\"bits\":\"", static_cast<unsigned long long>(event.time_us), bytes[0]);
+					output += number;
+					appendBits(output, bytes[0]);
+				}else{
+					snprintf(number, sizeof(number), "{\"time_us\":%llu,\"uart\":\"", static_cast<unsigned long long>(event.time_us));
+					output += number;
+					appendHex(output, bytes, event.size);
+				}
+				output += "\"}\n";
+				break;
+			case SampleFormat::binary:
+				{
+					uint64_t time_us = boost::endian::native_to_little(event.time_us);
+					uint32_t size = boost::endian::native_to_little(event.size);
+					output.append(reinterpret_cast<const char *>(&time_us), sizeof(time_us));
+					output += static_cast<char>(source);
+					output.append(reinterpret_cast<const char *>(&size), sizeof(size));
+					output.append(reinterpret_cast<const char *>(bytes), event.size);
+				}
+				break;
+		}
+	}
+}
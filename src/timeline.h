@@ -0,0 +1,71 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_TIMELINE_H_
+#define HEADER_TIMELINE_H_
+#include "sample_writer.h"
+#include <stdint.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+namespace command_line
+{
+	enum class TimelineSource: uint8_t
+	{
+		gpio,
+		uart,
+	};
+	struct Timeline
+	{
+		Timeline(SampleFormat format);
+		void addGpio(uint64_t time_us, uint8_t value);
+		void addUart(uint64_t time_us, const uint8_t *data, size_t size);
+		void advance(TimelineSource source, uint64_t time_us);
+		size_t merge(std::string &output);
+		size_t finish(std::string &output);
+		size_t getPending() const;
+		private:
+		struct Event
+		{
+			uint64_t time_us;
+			uint32_t offset, size;
+		};
+		struct Queue
+		{
+			std::vector<Event> events;
+			std::string data;
+			size_t next;
+			uint64_t watermark;
+			Queue();
+			bool hasEvent(uint64_t limit) const;
+			void compact();
+		};
+		SampleFormat m_format;
+		bool m_header;
+		Queue m_gpio, m_uart;
+		size_t merge(std::string &output, uint64_t limit);
+		void append(std::string &output, TimelineSource source, const Event &event, const std::string &data);
+	};
+}
+#endif /* HEADER_TIMELINE_H_ */
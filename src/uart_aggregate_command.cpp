@@ -0,0 +1,196 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef LINUX_BUILD
+#include "uart_aggregate_command.h"
+#include "uart_aggregator.h"
+#include "serial_port.h"
+#include "target.h"
+#include "mcp2200.h"
+#include "helpers.h"
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <chrono>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+namespace po = boost::program_options;
+namespace command_line
+{
+	static volatile sig_atomic_t interrupted = 0;
+	static void onInterrupt(int)
+	{
+		interrupted = 1;
+	}
+	UartAggregateCommand::UartAggregateCommand():
+		Command("uart-aggregate", "merge data received from serial ports of several devices into one stream")
+	{
+	}
+	UartAggregateCommand::~UartAggregateCommand()
+	{
+	}
+	void UartAggregateCommand::addOptions(po::options_description &options, po::options_description &hidden_options)
+	{
+		m_vendor_product.addOptions(options, hidden_options);
+		options.add_options()
+			("port", po::value<vector<string>>(&m_ports), "serial port path, can be repeated (serial ports of all found devices by default)")
+			("baud", po::value<int>(&m_baud_rate), "serial port baud rate (device default baud rate by default)")
+			("format,f", po::value<SampleFormat>(&m_format)->default_value(SampleFormat::text), "output format (text, csv, ndjson, binary)")
+			("output,o", po::value<string>(&m_output)->default_value("-"), "write records to this file (- for standard output)")
+			("duration,d", po::value<double>(&m_duration)->default_value(0), "stop after this many seconds (0 to run until interrupted)")
+			("flush-interval", po::value<int>(&m_flush_interval)->default_value(10), "maximum time in milliseconds received data is held before it is written")
+		;
+	}
+	bool UartAggregateCommand::checkOptions(po::variables_map &variable_map)
+	{
+		if (!m_vendor_product.checkOptions(variable_map)) return false;
+		m_baud_rate_set = variable_map.count("baud") > 0;
+		if (m_baud_rate_set && mcp2200::SerialPort::toStandardBaudRate(m_baud_rate) == 0){
+			cerr << "unsupported baud rate " << m_baud_rate << "\n";
+			return false;
+		}
+		if (!m_ports.empty() && !m_baud_rate_set){
+			cerr << "baud rate must be defined when ports are selected\n";
+			return false;
+		}
+		if (m_flush_interval < 0){
+			cerr << "flush interval must not be negative\n";
+			return false;
+		}
+		return true;
+	}
+	struct PortConfiguration
+	{
+		string path;
+		int baud_rate;
+		bool flow_control;
+	};
+	static bool findPorts(const VendorProduct &vendor_product, vector<PortConfiguration> &ports)
+	{
+		mcp2200::Device device;
+		device.find(vendor_product.getVendorId(), vendor_product.getProductId());
+		for (size_t i = 0; i < device.getCount(); i++){
+			PortConfiguration port;
+			auto information = device[i];
+			if (!mcp2200::SerialPort::findPath(information.path, port.path)){
+				cerr << "could not find serial port of " << information.path << "\n";
+				continue;
+			}
+			mcp2200::Device handle;
+			mcp2200::Command response;
+			if (!handle.open(information.path) || !handle.readAll(response)){
+				cerr << "could not read device configuration (" << information.path << ")\n";
+				continue;
+			}
+			port.baud_rate = response.getBaudRate();
+			port.flow_control = response.getFlowControl();
+			ports.push_back(port);
+		}
+		return !ports.empty();
+	}
+	bool UartAggregateCommand::run()
+	{
+		vector<PortConfiguration> configurations;
+		if (m_ports.empty()){
+			if (!findPorts(m_vendor_product, configurations)){
+				cerr << "could not find any serial ports (" << m_vendor_product << ")\n";
+				return false;
+			}
+		}else{
+			for (auto &path: m_ports)
+				configurations.push_back(PortConfiguration{path, 0, false});
+		}
+		vector<unique_ptr<mcp2200::SerialPort>> ports;
+		for (auto &configuration: configurations){
+			int baud_rate = m_baud_rate_set ? m_baud_rate : configuration.baud_rate;
+			unique_ptr<mcp2200::SerialPort> port(new mcp2200::SerialPort());
+			if (!port->open(configuration.path)){
+				cerr << "could not open serial port (" << configuration.path << ")\n";
+				return false;
+			}
+			if (!port->configure(baud_rate, configuration.flow_control)){
+				cerr << "could not configure serial port (" << configuration.path << ", baud rate " << baud_rate << ")\n";
+				return false;
+			}
+			ports.push_back(move(port));
+		}
+		int output_fd = m_output == "-" ? STDOUT_FILENO : ::open(m_output.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+		if (output_fd < 0){
+			cerr << "could not open output (" << m_output << ")\n";
+			return false;
+		}
+		UartAggregator aggregator(output_fd, m_format);
+		aggregator.setFlushInterval(chrono::milliseconds(m_flush_interval));
+		bool result = aggregator.open();
+		for (size_t i = 0; result && i < ports.size(); i++){
+			result = aggregator.addPort(ports[i]->getFd(), ports[i]->getPath());
+		}
+		if (!result){
+			cerr << "could not watch serial ports\n";
+			if (output_fd > STDOUT_FILENO) ::close(output_fd);
+			return false;
+		}
+		using clock = chrono::steady_clock;
+		interrupted = 0;
+		auto previous_handler = signal(SIGINT, onInterrupt);
+		auto start = clock::now();
+		auto end = start + chrono::duration_cast<clock::duration>(chrono::duration<double>(m_duration));
+		while (!interrupted && aggregator.getOpenPorts() > 0){
+			int timeout = -1;
+			if (m_duration > 0){
+				auto now = clock::now();
+				if (now >= end) break;
+				timeout = static_cast<int>(chrono::duration_cast<chrono::milliseconds>(end - now).count()) + 1;
+			}
+			if (!aggregator.poll(timeout)){
+				cerr << aggregator.getError() << "\n";
+				result = false;
+				break;
+			}
+		}
+		signal(SIGINT, previous_handler);
+		if (!aggregator.flush()){
+			cerr << aggregator.getError() << "\n";
+			result = false;
+		}
+		if (output_fd > STDOUT_FILENO) ::close(output_fd);
+		double seconds = chrono::duration<double>(clock::now() - start).count();
+		ostream_state_saver state(cerr);
+		cerr << fixed << setprecision(3);
+		uint64_t total = 0;
+		for (size_t i = 0; i < aggregator.getPortCount(); i++){
+			auto &statistics = aggregator.getStatistics(i);
+			total += statistics.bytes;
+			cerr << "port " << i << " (" << statistics.name << "): " << statistics.bytes << " bytes in " << statistics.records << " records, lag avg " << statistics.getAverageLag() << " ms, max " << statistics.max_lag << " ms" << (statistics.open ? "" : ", closed") << "\n";
+		}
+		cerr << "total: " << total << " bytes in " << seconds << " s";
+		if (seconds > 0)
+			cerr << " (" << setprecision(1) << total / seconds << " B/s)";
+		cerr << ", " << aggregator.getBytesWritten() << " bytes written\n";
+		return result;
+	}
+}
+#endif
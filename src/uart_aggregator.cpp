@@ -0,0 +1,249 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef LINUX_BUILD
+#include "uart_aggregator.h"
+#include "helpers.h"
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <boost/endian/conversion.hpp>
+using namespace std;
+namespace command_line
+{
+	template <typename T>
+	static void appendLittleEndian(string &output, T value)
+	{
+		value = boost::endian::native_to_little(value);
+		output.append(reinterpret_cast<const char *>(&value), sizeof(value));
+	}
+	UartAggregator::PortStatistics::PortStatistics(const string &name):
+		name(name),
+		bytes(0),
+		records(0),
+		total_lag(0),
+		max_lag(0),
+		open(true)
+	{
+	}
+	double UartAggregator::PortStatistics::getAverageLag() const
+	{
+		return records > 0 ? total_lag / records : 0;
+	}
+	UartAggregator::Port::Port(int fd, const string &name, size_t ring_capacity):
+		fd(fd),
+		ring(ring_capacity),
+		statistics(name)
+	{
+	}
+	UartAggregator::UartAggregator(int output_fd, SampleFormat format, size_t ring_capacity):
+		m_output_fd(output_fd),
+		m_epoll_fd(-1),
+		m_format(format),
+		m_ring_capacity(ring_capacity),
+		m_open_ports(0),
+		m_bytes_written(0),
+		m_header(format == SampleFormat::csv),
+		m_start(Clock::now()),
+		m_last_flush(m_start),
+		m_flush_interval(10000)
+	{
+	}
+	UartAggregator::~UartAggregator()
+	{
+		if (m_epoll_fd >= 0)
+			::close(m_epoll_fd);
+	}
+	bool UartAggregator::open()
+	{
+		m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+		return m_epoll_fd >= 0;
+	}
+	void UartAggregator::setFlushInterval(chrono::microseconds flush_interval)
+	{
+		m_flush_interval = flush_interval;
+	}
+	bool UartAggregator::addPort(int fd, const string &name)
+	{
+		epoll_event event = {};
+		event.events = EPOLLIN;
+		event.data.u64 = m_ports.size();
+		if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) return false;
+		m_ports.emplace_back(new Port(fd, name, m_ring_capacity));
+		m_open_ports++;
+		return true;
+	}
+	void UartAggregator::appendRecord(string &output, SampleFormat format, uint64_t time_us, uint16_t port, const mcp2200::RingBuffer::Segments &data)
+	{
+		char number[48];
+		switch (format){
+			case SampleFormat::text:
+				snprintf(number, sizeof(number), "%llu.%06llu %u ", static_cast<unsigned long long>(time_us / 1000000), static_cast<unsigned long long>(time_us % 1000000), port);
+				output += number;
+				appendHex(output, data.first, data.first_size);
+				appendHex(output, data.second, data.second_size);
+				output += '\n';
+				break;
+			case SampleFormat::csv:
+				snprintf(number, sizeof(number), "%llu,%u,", static_cast<unsigned long long>(time_us), port);
+				output += number;
+				appendHex(output, data.first, data.first_size);
+				appendHex(output, data.second, data.second_size);
+				output += '\n';
+				break;
+			case SampleFormat::ndjson:
+				snprintf(number, sizeof(number), "{\"time_us\":%llu,\"port\":%u,\"data\":\"", static_cast<unsigned long long>(time_us), port);
+				output += number;
+				appendHex(output, data.first, data.first_size);
+				appendHex(output, data.second, data.second_size);
+				output += "\"}\n";
+				break;
+			case SampleFormat::binary:
+				appendLittleEndian<uint64_t>(output, time_us);
+				appendLittleEndian<uint16_t>(output, port);
+				appendLittleEndian<uint32_t>(output, static_cast<uint32_t>(data.size()));
+				output.append(reinterpret_cast<const char *>(data.first), data.first_size);
+				output.append(reinterpret_cast<const char *>(data.second), data.second_size);
+				break;
+		}
+	}
+	void UartAggregator::drain(size_t index, Clock::time_point now)
+	{
+		auto &port = *m_ports[index];
+		if (port.ring.empty()) return;
+		if (m_header){
+			m_output += "time_us,port,data\n";
+			m_header = false;
+		}
+		auto data = port.ring.peek();
+		auto time_us = chrono::duration_cast<chrono::microseconds>(port.first_pending - m_start).count();
+		appendRecord(m_output, m_format, time_us, static_cast<uint16_t>(index), data);
+		double lag = chrono::duration<double, milli>(now - port.first_pending).count();
+		port.statistics.bytes += data.size();
+		port.statistics.records++;
+		port.statistics.total_lag += lag;
+		port.statistics.max_lag = max(port.statistics.max_lag, lag);
+		port.ring.consume(data.size());
+	}
+	bool UartAggregator::writeOutput()
+	{
+		const char *data = m_output.data();
+		size_t size = m_output.size();
+		while (size > 0){
+			ssize_t wrote = ::write(m_output_fd, data, size);
+			if (wrote < 0){
+				if (errno == EINTR) continue;
+				m_error = string("could not write output: ") + strerror(errno);
+				return false;
+			}
+			data += wrote;
+			size -= wrote;
+		}
+		m_bytes_written += m_output.size();
+		m_output.clear();
+		return true;
+	}
+	bool UartAggregator::flush()
+	{
+		auto now = Clock::now();
+		for (size_t i = 0; i < m_ports.size(); i++){
+			drain(i, now);
+		}
+		m_last_flush = now;
+		return writeOutput();
+	}
+	void UartAggregator::closePort(size_t index)
+	{
+		auto &port = *m_ports[index];
+		epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, port.fd, nullptr);
+		port.statistics.open = false;
+		m_open_ports--;
+	}
+	bool UartAggregator::poll(int timeout)
+	{
+		// Received data stays in the per port ring buffers until the flush interval passes, so bursts from
+		// all ports end up in one large write.
+		bool pending = false;
+		for (auto &port: m_ports){
+			if (!port->ring.empty()) pending = true;
+		}
+		if (pending){
+			// Rounded up, otherwise the last partial millisecond is spent polling with zero timeout.
+			auto until_flush = chrono::ceil<chrono::milliseconds>(m_last_flush + m_flush_interval - Clock::now()).count();
+			until_flush = max<decltype(until_flush)>(until_flush, 0);
+			if (timeout < 0 || until_flush < timeout)
+				timeout = static_cast<int>(until_flush);
+		}
+		epoll_event events[16];
+		int count = epoll_wait(m_epoll_fd, events, 16, timeout);
+		if (count < 0){
+			if (errno == EINTR) return true;
+			m_error = string("could not wait for serial port data: ") + strerror(errno);
+			return false;
+		}
+		auto now = Clock::now();
+		for (int i = 0; i < count; i++){
+			size_t index = events[i].data.u64;
+			auto &port = *m_ports[index];
+			if (port.ring.space() == 0)
+				drain(index, now);
+			bool was_empty = port.ring.empty();
+			ssize_t read = port.ring.readFrom(port.fd);
+			if (read > 0){
+				if (was_empty)
+					port.first_pending = now;
+			}else if (read == 0 || (errno != EAGAIN && errno != EINTR)){
+				closePort(index);
+			}
+		}
+		if (now - m_last_flush >= m_flush_interval || m_output.size() >= 256 * 1024 || m_open_ports == 0){
+			return flush();
+		}
+		return true;
+	}
+	size_t UartAggregator::getOpenPorts() const
+	{
+		return m_open_ports;
+	}
+	uint64_t UartAggregator::getBytesWritten() const
+	{
+		return m_bytes_written;
+	}
+	const UartAggregator::PortStatistics &UartAggregator::getStatistics(size_t index) const
+	{
+		return m_ports[index]->statistics;
+	}
+	size_t UartAggregator::getPortCount() const
+	{
+		return m_ports.size();
+	}
+	const string &UartAggregator::getError() const
+	{
+		return m_error;
+	}
+}
+#endif
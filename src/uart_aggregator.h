@@ -0,0 +1,86 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_UART_AGGREGATOR_H_
+#define HEADER_UART_AGGREGATOR_H_
+#include "ring_buffer.h"
+#include "sample_writer.h"
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+namespace command_line
+{
+	struct UartAggregator
+	{
+		typedef std::chrono::steady_clock Clock;
+		struct PortStatistics
+		{
+			std::string name;
+			uint64_t bytes, records;
+			double total_lag, max_lag;
+			bool open;
+			PortStatistics(const std::string &name);
+			double getAverageLag() const;
+		};
+		UartAggregator(int output_fd, SampleFormat format, size_t ring_capacity = 64 * 1024);
+		~UartAggregator();
+		bool open();
+		bool addPort(int fd, const std::string &name);
+		bool poll(int timeout);
+		bool flush();
+		void setFlushInterval(std::chrono::microseconds flush_interval);
+		size_t getOpenPorts() const;
+		uint64_t getBytesWritten() const;
+		const PortStatistics &getStatistics(size_t index) const;
+		size_t getPortCount() const;
+		const std::string &getError() const;
+		static void appendRecord(std::string &output, SampleFormat format, uint64_t time_us, uint16_t port, const mcp2200::RingBuffer::Segments &data);
+		private:
+		struct Port
+		{
+			int fd;
+			mcp2200::RingBuffer ring;
+			Clock::time_point first_pending;
+			PortStatistics statistics;
+			Port(int fd, const std::string &name, size_t ring_capacity);
+		};
+		int m_output_fd, m_epoll_fd;
+		SampleFormat m_format;
+		size_t m_ring_capacity, m_open_ports;
+		uint64_t m_bytes_written;
+		bool m_header;
+		Clock::time_point m_start, m_last_flush;
+		std::chrono::microseconds m_flush_interval;
+		std::vector<std::unique_ptr<Port>> m_ports;
+		std::string m_output, m_error;
+		void drain(size_t index, Clock::time_point now);
+		bool writeOutput();
+		void closePort(size_t index);
+		UartAggregator(UartAggregator const &) = delete;
+		void operator=(UartAggregator const &x) = delete;
+	};
+}
+#endif /* HEADER_UART_AGGREGATOR_H_ */
@@ -0,0 +1,127 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef LINUX_BUILD
+#include "uart_bench_command.h"
+#include "loopback_benchmark.h"
+#include "serial_port.h"
+#include "helpers.h"
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+using namespace std;
+namespace po = boost::program_options;
+namespace command_line
+{
+	UartBenchCommand::UartBenchCommand():
+		DeviceCommand("uart-bench", "measure serial port loopback latency and throughput at each baud rate")
+	{
+	}
+	UartBenchCommand::~UartBenchCommand()
+	{
+	}
+	void UartBenchCommand::addOptions(po::options_description &options, po::options_description &hidden_options)
+	{
+		DeviceCommand::addOptions(options, hidden_options);
+		m_serial_target.addOptions(options, hidden_options);
+		options.add_options()
+			("samples,n", po::value<size_t>(&m_samples)->default_value(100), "number of latency samples for each baud rate")
+			("duration,d", po::value<double>(&m_duration)->default_value(1.0), "approximate throughput test duration in seconds for each baud rate")
+			("timeout,t", po::value<int>(&m_timeout)->default_value(1000), "time to wait for looped back data in milliseconds")
+		;
+	}
+	bool UartBenchCommand::checkOptions(po::variables_map &variable_map)
+	{
+		if (!DeviceCommand::checkOptions(variable_map)) return false;
+		return m_serial_target.checkOptions(variable_map);
+	}
+	bool UartBenchCommand::run(mcp2200::Device &device)
+	{
+		mcp2200::Command original;
+		if (!device.readAll(original)){
+			cerr << "could not read device configuration\n";
+			return false;
+		}
+		mcp2200::SerialPort port;
+		if (!m_serial_target.open(m_target, device, port)){
+			return false;
+		}
+		vector<int> baud_rates;
+		if (m_serial_target.isBaudRateSet()){
+			baud_rates.push_back(mcp2200::SerialPort::toStandardBaudRate(m_serial_target.getBaudRate()));
+		}else{
+			for (auto baud_rate: mcp2200::SerialPort::getStandardBaudRates()){
+				if (mcp2200::SerialPort::toStandardBaudRate(mcp2200::fromBaudRateDivisor(mcp2200::toBaudRateDivisor(baud_rate))) == baud_rate)
+					baud_rates.push_back(baud_rate);
+			}
+		}
+		ostream_state_saver state(cout);
+		cout << fixed
+			<< setw(9) << "baud" << setw(9) << "device" << setw(8) << "error"
+			<< setw(12) << "B/s" << setw(10) << "p50 us" << setw(10) << "p90 us" << setw(10) << "p99 us" << setw(10) << "max us"
+			<< setw(10) << "byte err" << "\n";
+		bool result = true;
+		for (auto baud_rate: baud_rates){
+			int device_baud_rate = mcp2200::fromBaudRateDivisor(mcp2200::toBaudRateDivisor(baud_rate));
+			if (!device.configure([baud_rate](mcp2200::Command &command){
+				command.setBaudRate(baud_rate);
+			}) || !port.configure(baud_rate, original.getFlowControl())){
+				cerr << "could not set baud rate " << baud_rate << "\n";
+				result = false;
+				break;
+			}
+			// 10 bits are transferred for each byte (start, 8 data bits and stop).
+			size_t bytes = max<size_t>(16, static_cast<size_t>(baud_rate / 10 * m_duration));
+			mcp2200::LoopbackBenchmark benchmark;
+			benchmark
+				.setLatencySamples(m_samples)
+				.setThroughputBytes(bytes)
+				.setTimeout(m_timeout);
+			mcp2200::LoopbackResult loopback;
+			if (!benchmark.run(port.getFd(), loopback)){
+				cerr << "serial port I/O failed at baud rate " << baud_rate << "\n";
+				result = false;
+				break;
+			}
+			cout
+				<< setw(9) << baud_rate << setw(9) << device_baud_rate
+				<< setw(7) << setprecision(2) << 100.0 * abs(device_baud_rate - baud_rate) / baud_rate << "%"
+				<< setw(12) << setprecision(1) << loopback.throughput
+				<< setw(10) << loopback.latency_p50 << setw(10) << loopback.latency_p90 << setw(10) << loopback.latency_p99 << setw(10) << loopback.latency_max
+				<< setw(9) << setprecision(3) << 100.0 * loopback.getErrorRate() << "%";
+			if (loopback.latency_timeouts > 0)
+				cout << " (" << loopback.latency_timeouts << " latency timeouts)";
+			cout << "\n" << flush;
+		}
+		int original_baud_rate = original.getBaudRate();
+		if (!device.configure([original_baud_rate](mcp2200::Command &command){
+			command.setBaudRate(original_baud_rate);
+		})){
+			cerr << "could not restore baud rate " << original_baud_rate << "\n";
+			result = false;
+		}
+		return result;
+	}
+}
+#endif
@@ -0,0 +1,183 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef LINUX_BUILD
+#include "uart_command.h"
+#include "serial_target.h"
+#include "serial_port.h"
+#include "helpers.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <csignal>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+using namespace std;
+namespace po = boost::program_options;
+namespace command_line
+{
+	static volatile sig_atomic_t interrupted = 0;
+	static void onInterrupt(int)
+	{
+		interrupted = 1;
+	}
+	static void printThroughput(const char *direction, uint64_t bytes, chrono::steady_clock::duration duration)
+	{
+		double seconds = chrono::duration<double>(duration).count();
+		ostream_state_saver state(cerr);
+		cerr << direction << " " << bytes << " bytes in " << fixed << setprecision(3) << seconds << " s";
+		if (seconds > 0)
+			cerr << " (" << setprecision(1) << bytes / seconds << " B/s)";
+		cerr << "\n";
+	}
+	UartCommand::UartCommand():
+		DeviceCommand("uart", "transfer data through the serial port of the device")
+	{
+	}
+	UartCommand::~UartCommand()
+	{
+	}
+	void UartCommand::addOptions(po::options_description &options, po::options_description &hidden_options)
+	{
+		DeviceCommand::addOptions(options, hidden_options);
+		m_serial_target.addOptions(options, hidden_options);
+		options.add_options()
+			("input,i", po::value<string>(&m_input), "send data from this file (- for standard input)")
+			("output,o", po::value<string>(&m_output), "write received data to this file (- for standard output)")
+			("idle-timeout,t", po::value<int>(&m_idle_timeout)->default_value(1000), "stop receiving after this many milliseconds without data once input is sent (0 to wait forever)")
+		;
+	}
+	bool UartCommand::checkOptions(po::variables_map &variable_map)
+	{
+		if (!DeviceCommand::checkOptions(variable_map)) return false;
+		if (!m_serial_target.checkOptions(variable_map)) return false;
+		m_input_set = variable_map.count("input") > 0;
+		m_output_set = variable_map.count("output") > 0;
+		if (!m_input_set && !m_output_set){
+			cerr << "input or output must be defined\n";
+			return false;
+		}
+		return true;
+	}
+	bool UartCommand::run(mcp2200::Device &device)
+	{
+		using clock = chrono::steady_clock;
+		mcp2200::SerialPort port;
+		if (!m_serial_target.open(m_target, device, port)){
+			return false;
+		}
+		int input_fd = -1, output_fd = -1;
+		if (m_input_set){
+			input_fd = m_input == "-" ? STDIN_FILENO : ::open(m_input.c_str(), O_RDONLY | O_CLOEXEC);
+			if (input_fd < 0){
+				cerr << "could not open input (" << m_input << ")\n";
+				return false;
+			}
+		}
+		if (m_output_set){
+			output_fd = m_output == "-" ? STDOUT_FILENO : ::open(m_output.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+			if (output_fd < 0){
+				cerr << "could not open output (" << m_output << ")\n";
+				if (input_fd > STDIN_FILENO) ::close(input_fd);
+				return false;
+			}
+		}
+		// Writes to the port must not block, otherwise received data is lost while a large chunk is sent at a low baud rate.
+		if (m_input_set && !port.setNonBlocking(true)){
+			cerr << "could not configure serial port (" << port.getPath() << ")\n";
+			if (input_fd > STDIN_FILENO) ::close(input_fd);
+			if (output_fd > STDOUT_FILENO) ::close(output_fd);
+			return false;
+		}
+		mcp2200::StreamPump send(input_fd, port.getFd()), receive(port.getFd(), output_fd);
+		bool sending = m_input_set, receiving = m_output_set, result = true;
+		interrupted = 0;
+		auto previous_handler = signal(SIGINT, onInterrupt);
+		auto start = clock::now(), send_end = start, receive_end = start, last_receive = start;
+		while (!interrupted && (sending || receiving)){
+			pollfd fds[2];
+			int count = 0, send_index = -1, port_index = -1;
+			bool send_blocked = sending && send.isBlocked();
+			if (sending && !send_blocked){
+				send_index = count;
+				fds[count++] = {input_fd, POLLIN, 0};
+			}
+			if (receiving || send_blocked){
+				port_index = count;
+				fds[count++] = {port.getFd(), static_cast<short>((receiving ? POLLIN : 0) | (send_blocked ? POLLOUT : 0)), 0};
+			}
+			// Receive only runs have nothing to wait for, so they stop on interrupt or end of data only.
+			bool idle = m_input_set && !sending && m_idle_timeout > 0;
+			int timeout = idle ? m_idle_timeout : -1;
+			int ready = poll(fds, count, timeout);
+			if (ready < 0){
+				if (errno == EINTR) continue;
+				result = false;
+				break;
+			}
+			auto now = clock::now();
+			if (ready == 0){
+				if (idle && now - last_receive >= chrono::milliseconds(m_idle_timeout)) break;
+				continue;
+			}
+			bool send_ready = (send_index >= 0 && fds[send_index].revents) || (send_blocked && (fds[port_index].revents & (POLLOUT | POLLERR | POLLHUP)));
+			if (send_ready){
+				if (send.transfer() < 0){
+					cerr << "could not send data\n";
+					result = false;
+					break;
+				}
+				send_end = now;
+				if (send.isFinished()){
+					sending = false;
+					last_receive = now;
+				}
+			}
+			if (receiving && (fds[port_index].revents & (POLLIN | POLLERR | POLLHUP))){
+				if (receive.transfer() < 0){
+					cerr << "could not receive data\n";
+					result = false;
+					break;
+				}else if (receive.isFinished()){
+					receiving = false;
+				}else{
+					receive_end = last_receive = now;
+				}
+			}
+		}
+		signal(SIGINT, previous_handler);
+		if (m_input_set){
+			port.drain();
+			printThroughput("sent", send.getBytes(), send_end - start);
+			if (input_fd > STDIN_FILENO) ::close(input_fd);
+		}
+		if (m_output_set){
+			printThroughput("received", receive.getBytes(), receive_end - start);
+			if (output_fd > STDOUT_FILENO) ::close(output_fd);
+		}
+		return result;
+	}
+}
+#endif
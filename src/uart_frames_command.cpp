@@ -0,0 +1,321 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef LINUX_BUILD
+#include "uart_frames_command.h"
+#include "serial_port.h"
+#include "helpers.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <vector>
+#include <unistd.h>
+#include <poll.h>
+#include <boost/program_options/errors.hpp>
+#include <boost/program_options/value_semantic.hpp>
+#include <boost/algorithm/string.hpp>
+#include <boost/endian/conversion.hpp>
+using namespace std;
+namespace po = boost::program_options;
+namespace command_line
+{
+	static volatile sig_atomic_t interrupted = 0;
+	static void onInterrupt(int)
+	{
+		interrupted = 1;
+	}
+	void validate(boost::any &v, const std::vector<std::string> &values, Framing *, int)
+	{
+		using namespace boost::program_options;
+		validators::check_first_occurrence(v);
+		auto value_string = validators::get_single_string(values);
+		boost::algorithm::to_lower(value_string);
+		Framing framing = Framing::line;
+		if (value_string == "line")
+			framing = Framing::line;
+		else if (value_string == "length")
+			framing = Framing::length;
+		else if (value_string == "modbus")
+			framing = Framing::modbus;
+		else
+			throw validation_error(validation_error::invalid_option_value);
+		v = boost::any(framing);
+	}
+	ostream& operator<<(ostream& stream, const Framing &framing)
+	{
+		switch (framing){
+			case Framing::line:
+				stream << "line";
+				break;
+			case Framing::length:
+				stream << "length";
+				break;
+			case Framing::modbus:
+				stream << "modbus";
+				break;
+		}
+		return stream;
+	}
+	static bool writeAll(int fd, const string &data)
+	{
+		size_t offset = 0;
+		while (offset < data.size()){
+			ssize_t wrote = ::write(fd, data.data() + offset, data.size() - offset);
+			if (wrote < 0){
+				if (errno == EINTR) continue;
+				return false;
+			}
+			offset += wrote;
+		}
+		return true;
+	}
+	UartFramesCommand::UartFramesCommand():
+		DeviceCommand("uart-frames", "split data received from the serial port of the device into frames")
+	{
+	}
+	UartFramesCommand::~UartFramesCommand()
+	{
+	}
+	void UartFramesCommand::addOptions(po::options_description &options, po::options_description &hidden_options)
+	{
+		DeviceCommand::addOptions(options, hidden_options);
+		m_serial_target.addOptions(options, hidden_options);
+		options.add_options()
+			("framing,F", po::value<Framing>(&m_framing)->default_value(Framing::line), "framing (line, length, modbus)")
+			("prefix-size", po::value<size_t>(&m_prefix_size)->default_value(2), "length prefix size in bytes (1, 2 or 4)")
+			("little-endian", po::value<bool>(&m_little_endian)->default_value(false)->zero_tokens(), "length prefix is little endian")
+			("max-length", po::value<size_t>(&m_max_length)->default_value(4096), "maximum frame size (256 for modbus framing unless set)")
+			("format,f", po::value<SampleFormat>(&m_format)->default_value(SampleFormat::text), "output format (text, csv, ndjson, binary)")
+			("count,n", po::value<size_t>(&m_count)->default_value(0), "stop after this many frames (0 to run until interrupted)")
+			("benchmark,b", po::value<size_t>(&m_benchmark)->default_value(0), "decode this many generated frames in memory and print decoding speed instead of reading the serial port")
+		;
+	}
+	bool UartFramesCommand::checkOptions(po::variables_map &variable_map)
+	{
+		if (!DeviceCommand::checkOptions(variable_map)) return false;
+		if (!m_serial_target.checkOptions(variable_map)) return false;
+		if (m_prefix_size != 1 && m_prefix_size != 2 && m_prefix_size != 4){
+			cerr << "prefix size must be 1, 2 or 4\n";
+			return false;
+		}
+		m_max_length_set = !variable_map["max-length"].defaulted();
+		if (m_max_length == 0 || m_max_length > 1024 * 1024){
+			cerr << "maximum frame size must be between 1 and 1048576\n";
+			return false;
+		}
+		return true;
+	}
+	unique_ptr<mcp2200::FrameDecoder> UartFramesCommand::createDecoder(int baud_rate) const
+	{
+		switch (m_framing){
+			case Framing::length:
+				return unique_ptr<mcp2200::FrameDecoder>(new mcp2200::LengthPrefixedDecoder(m_prefix_size, !m_little_endian, m_max_length));
+			case Framing::modbus:
+				return unique_ptr<mcp2200::FrameDecoder>(new mcp2200::ModbusRtuDecoder(baud_rate, m_max_length_set ? m_max_length : mcp2200::ModbusRtuDecoder::max_adu_length));
+			case Framing::line:
+			default:
+				return unique_ptr<mcp2200::FrameDecoder>(new mcp2200::LineDecoder(m_max_length));
+		}
+	}
+	void UartFramesCommand::appendFrame(string &output, SampleFormat format, const mcp2200::Frame &frame)
+	{
+		char number[48];
+		const auto &data = frame.data;
+		switch (format){
+			case SampleFormat::text:
+				snprintf(number, sizeof(number), "%llu.%06llu ", static_cast<unsigned long long>(frame.time_us / 1000000), static_cast<unsigned long long>(frame.time_us % 1000000));
+				output += number;
+				appendHex(output, data.first, data.first_size);
+				appendHex(output, data.second, data.second_size);
+				output += frame.valid ? "\n" : " invalid\n";
+				break;
+			case SampleFormat::csv:
+				snprintf(number, sizeof(number), "%llu,%d,", static_cast<unsigned long long>(frame.time_us), frame.valid ? 1 : 0);
+				output += number;
+				appendHex(output, data.first, data.first_size);
+				appendHex(output, data.second, data.second_size);
+				output += '\n';
+				break;
+			case SampleFormat::ndjson:
+				snprintf(number, sizeof(number), "{\"time_us\":%llu,\"valid\":%s,\"data\":\"", static_cast<unsigned long long>(frame.time_us), frame.valid ? "true" : "false");
+				output += number;
+				appendHex(output, data.first, data.first_size);
+				appendHex(output, data.second, data.second_size);
+				output += "\"}\n";
+				break;
+			case SampleFormat::binary:
+				{
+					uint64_t time_us = boost::endian::native_to_little(frame.time_us);
+					uint32_t size = boost::endian::native_to_little(static_cast<uint32_t>(data.size()));
+					output.append(reinterpret_cast<const char *>(&time_us), sizeof(time_us));
+					output += static_cast<char>(frame.valid ? 1 : 0);
+					output.append(reinterpret_cast<const char *>(&size), sizeof(size));
+					output.append(reinterpret_cast<const char *>(data.first), data.first_size);
+					output.append(reinterpret_cast<const char *>(data.second), data.second_size);
+				}
+				break;
+		}
+	}
+	bool UartFramesCommand::run()
+	{
+		if (m_benchmark > 0) return runBenchmark();
+		return DeviceCommand::run();
+	}
+	bool UartFramesCommand::run(mcp2200::Device &device)
+	{
+		if (m_benchmark > 0) return runBenchmark();
+		using clock = chrono::steady_clock;
+		mcp2200::SerialPort port;
+		if (!m_serial_target.open(m_target, device, port)){
+			return false;
+		}
+		mcp2200::FrameStage stage(createDecoder(m_serial_target.getPortBaudRate()));
+		string output;
+		if (m_format == SampleFormat::csv)
+			output += "time_us,valid,data\n";
+		size_t frames = 0;
+		auto onFrame = [this, &output, &frames](const mcp2200::Frame &frame){
+			if (m_count > 0 && frames >= m_count) return;
+			appendFrame(output, m_format, frame);
+			frames++;
+		};
+		bool result = true;
+		interrupted = 0;
+		auto previous_handler = signal(SIGINT, onInterrupt);
+		auto start = clock::now();
+		while (!interrupted && (m_count == 0 || frames < m_count)){
+			uint64_t now = chrono::duration_cast<chrono::microseconds>(clock::now() - start).count();
+			int64_t timeout = stage.getTimeout(now);
+			timespec wait = {static_cast<time_t>(timeout / 1000000), static_cast<long>(timeout % 1000000) * 1000};
+			pollfd fds = {port.getFd(), POLLIN, 0};
+			// Modbus frames are ended by a few milliseconds of silence, so waiting uses microsecond resolution.
+			int ready = ppoll(&fds, 1, timeout >= 0 ? &wait : nullptr, nullptr);
+			if (ready < 0){
+				if (errno == EINTR) continue;
+				result = false;
+				break;
+			}
+			now = chrono::duration_cast<chrono::microseconds>(clock::now() - start).count();
+			if (ready == 0){
+				stage.expire(now, onFrame);
+			}else if (stage.receive(port.getFd(), now, onFrame) <= 0){
+				break;
+			}
+			if (!output.empty()){
+				if (!writeAll(STDOUT_FILENO, output)){
+					result = false;
+					break;
+				}
+				output.clear();
+			}
+		}
+		signal(SIGINT, previous_handler);
+		double seconds = chrono::duration<double>(clock::now() - start).count();
+		ostream_state_saver state(cerr);
+		cerr << stage.getFrames() << " frames (" << stage.getInvalidFrames() << " invalid, " << stage.getDiscardedBytes() << " bytes discarded) in " << fixed << setprecision(3) << seconds << " s";
+		if (seconds > 0)
+			cerr << " (" << setprecision(1) << stage.getFrames() / seconds << " frames/s)";
+		cerr << "\n";
+		return result;
+	}
+	static void appendGeneratedFrame(vector<uint8_t> &stream, Framing framing, size_t prefix_size, bool little_endian, size_t index)
+	{
+		const size_t payload_size = 32;
+		size_t start = stream.size();
+		switch (framing){
+			case Framing::line:
+				for (size_t i = 0; i < payload_size; i++)
+					stream.push_back('a' + (index + i) % 26);
+				stream.push_back('\r');
+				stream.push_back('\n');
+				break;
+			case Framing::length:
+				for (size_t i = 0; i < prefix_size; i++){
+					size_t shift = little_endian ? i : prefix_size - 1 - i;
+					stream.push_back(static_cast<uint8_t>(payload_size >> (shift * 8)));
+				}
+				for (size_t i = 0; i < payload_size; i++)
+					stream.push_back(static_cast<uint8_t>(index + i));
+				break;
+			case Framing::modbus:
+				{
+					for (size_t i = 0; i < payload_size - 2; i++)
+						stream.push_back(static_cast<uint8_t>(index + i));
+					uint16_t crc = mcp2200::ModbusRtuDecoder::crc(mcp2200::RingBuffer::Segments{&stream[start], nullptr, payload_size - 2, 0});
+					stream.push_back(crc & 0xff);
+					stream.push_back(crc >> 8);
+				}
+				break;
+		}
+	}
+	bool UartFramesCommand::runBenchmark()
+	{
+		using clock = chrono::steady_clock;
+		const size_t generated_frames = 1024;
+		vector<uint8_t> stream;
+		vector<size_t> frame_ends;
+		for (size_t i = 0; i < generated_frames; i++){
+			appendGeneratedFrame(stream, m_framing, m_prefix_size, m_little_endian, i);
+			frame_ends.push_back(stream.size());
+		}
+		const int baud_rate = 115200;
+		mcp2200::FrameStage stage(createDecoder(baud_rate));
+		uint64_t gap_us = stage.getDecoder().getGap().count(), time_us = 0, bytes = 0, checksum = 0;
+		auto onFrame = [&checksum](const mcp2200::Frame &frame){
+			checksum += frame.data.size() + frame.data[0];
+		};
+		auto start = clock::now();
+		while (stage.getFrames() < m_benchmark){
+			if (gap_us > 0){
+				// Timing based framing needs silence between frames, so frames are written one by one with simulated gaps.
+				size_t previous = 0;
+				for (size_t i = 0; i < frame_ends.size() && stage.getFrames() < m_benchmark; i++){
+					stage.write(&stream[previous], frame_ends[i] - previous, time_us, onFrame);
+					bytes += frame_ends[i] - previous;
+					time_us += gap_us;
+					stage.expire(time_us, onFrame);
+					previous = frame_ends[i];
+				}
+			}else{
+				const size_t chunk_size = 4096;
+				for (size_t offset = 0; offset < stream.size(); offset += chunk_size){
+					size_t size = min(chunk_size, stream.size() - offset);
+					stage.write(&stream[offset], size, time_us++, onFrame);
+					bytes += size;
+				}
+			}
+		}
+		double seconds = chrono::duration<double>(clock::now() - start).count();
+		ostream_state_saver state(cout);
+		cout << "framing: " << m_framing << ", frames: " << stage.getFrames() << ", invalid: " << stage.getInvalidFrames() << ", bytes: " << bytes << ", checksum: " << checksum << "\n";
+		cout << fixed << setprecision(3) << "time: " << seconds << " s";
+		if (seconds > 0)
+			cout << setprecision(0) << ", " << stage.getFrames() / seconds << " frames/s, " << setprecision(1) << bytes / seconds / (1024 * 1024) << " MiB/s";
+		cout << "\n";
+		return stage.getInvalidFrames() == 0;
+	}
+}
+#endif
@@ -0,0 +1,65 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef HEADER_UART_FRAMES_COMMAND_H_
+#define HEADER_UART_FRAMES_COMMAND_H_
+#include "device_command.h"
+#include "serial_target.h"
+#include "sample_writer.h"
+#include "frame_decoder.h"
+#include <boost/program_options/options_description.hpp>
+#include <boost/program_options/variables_map.hpp>
+#include <iostream>
+#include <memory>
+#include <string>
+namespace command_line
+{
+	enum class Framing: uint8_t
+	{
+		line,
+		length,
+		modbus,
+	};
+	void validate(boost::any &v, const std::vector<std::string> &values, Framing *, int);
+	std::ostream& operator<<(std::ostream& stream, const Framing &framing);
+	struct UartFramesCommand: public DeviceCommand
+	{
+		UartFramesCommand();
+		virtual ~UartFramesCommand();
+		virtual void addOptions(boost::program_options::options_description &options, boost::program_options::options_description &hidden_options);
+		virtual bool checkOptions(boost::program_options::variables_map &variable_map);
+		virtual bool run();
+		virtual bool run(mcp2200::Device &device);
+		static void appendFrame(std::string &output, SampleFormat format, const mcp2200::Frame &frame);
+		private:
+		SerialTarget m_serial_target;
+		Framing m_framing;
+		SampleFormat m_format;
+		size_t m_prefix_size, m_max_length, m_count, m_benchmark;
+		bool m_little_endian, m_max_length_set;
+		std::unique_ptr<mcp2200::FrameDecoder> createDecoder(int baud_rate) const;
+		bool runBenchmark();
+	};
+}
+#endif /* HEADER_UART_FRAMES_COMMAND_H_ */
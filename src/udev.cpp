@@ -0,0 +1,295 @@
+/*
+Copyright (c) 2016, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifdef HAVE_LIBUDEV
+#include "udev.h"
+#include <unistd.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <libudev.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstdio>
+using namespace std;
+namespace mcp2200
+{
+	UdevEvent::UdevEvent():
+		action(Action::add),
+		vendor_id(0),
+		product_id(0),
+		release_number(0)
+	{
+	}
+	Udev::Udev():
+		m_filter(0)
+	{
+		m_udev = nullptr;
+		m_epoll_fd = -1;
+		m_event_fd = -1;
+	}
+	Udev::~Udev()
+	{
+		if (m_epoll_fd >= 0)
+			::close(m_epoll_fd);
+		if (m_event_fd >= 0)
+			::close(m_event_fd);
+		if (m_udev)
+			udev_unref(m_udev);
+	}
+	bool Udev::open(bool kernel_events)
+	{
+		m_udev = udev_new();
+		m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+		if (m_epoll_fd < 0){
+			return false;
+		}
+		m_event_fd = eventfd(0, EFD_CLOEXEC);
+		if (m_event_fd < 0){
+			return false;
+		}
+		epoll_event ep_udev = {};
+		ep_udev.events = EPOLLIN;
+		ep_udev.data.fd = m_event_fd;
+		if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_event_fd, &ep_udev) < 0) {
+			return false;
+		}
+		unique_ptr<UdevMonitor> monitor;
+		monitor.reset(new UdevMonitor());
+		if (monitor->open(*this, "udev") && monitor->setupEpoll(m_epoll_fd) && monitor->setFilter()){
+			m_monitors.push_back(std::move(monitor));
+		}
+		// Kernel events arrive before udev rules are applied, so the device node may not be accessible yet. Each device change is then reported twice.
+		if (kernel_events){
+			monitor.reset(new UdevMonitor());
+			if (monitor->open(*this, "kernel") && monitor->setupEpoll(m_epoll_fd) && monitor->setFilter()){
+				m_monitors.push_back(std::move(monitor));
+			}
+		}
+		if (m_monitors.empty()) return false;
+		addPresentDevices();
+		return true;
+	}
+	void Udev::close()
+	{
+		m_monitors.clear();
+		m_devices.clear();
+		if (m_epoll_fd >= 0)
+			::close(m_epoll_fd);
+		m_epoll_fd = -1;
+		if (m_event_fd >= 0)
+			::close(m_event_fd);
+		m_event_fd = -1;
+		if (m_udev)
+			udev_unref(m_udev);
+		m_udev = nullptr;
+	}
+	Udev::operator udev*()
+	{
+		return m_udev;
+	}
+	void Udev::setFilter(uint16_t vendor_id, uint16_t product_id)
+	{
+		m_filter = (static_cast<uint32_t>(vendor_id) << 16) | product_id;
+	}
+	static uint16_t parseHex(const char *value)
+	{
+		return value ? static_cast<uint16_t>(strtoul(value, nullptr, 16)) : 0;
+	}
+	static string toString(const char *value)
+	{
+		return value ? value : "";
+	}
+	static bool getIds(udev_device *device, uint16_t &vendor_id, uint16_t &product_id)
+	{
+		const char *vendor = udev_device_get_property_value(device, "ID_VENDOR_ID");
+		const char *model = udev_device_get_property_value(device, "ID_MODEL_ID");
+		if (vendor && model){
+			vendor_id = parseHex(vendor);
+			product_id = parseHex(model);
+			return true;
+		}
+		// HID_ID property of the parent HID device has the form "bus:vendor:product", all numbers in hexadecimal.
+		udev_device *hid = udev_device_get_parent_with_subsystem_devtype(device, "hid", nullptr);
+		const char *hid_id = hid ? udev_device_get_property_value(hid, "HID_ID") : nullptr;
+		if (!hid_id) return false;
+		unsigned int bus, vendor_value, product_value;
+		if (sscanf(hid_id, "%x:%x:%x", &bus, &vendor_value, &product_value) != 3) return false;
+		vendor_id = static_cast<uint16_t>(vendor_value);
+		product_id = static_cast<uint16_t>(product_value);
+		return true;
+	}
+	static bool readDevice(udev_device *device, UdevEvent &event)
+	{
+		if (!getIds(device, event.vendor_id, event.product_id)) return false;
+		udev_device *usb = udev_device_get_parent_with_subsystem_devtype(device, "usb", "usb_device");
+		if (usb){
+			event.serial = toString(udev_device_get_sysattr_value(usb, "serial"));
+			event.manufacturer = toString(udev_device_get_sysattr_value(usb, "manufacturer"));
+			event.product = toString(udev_device_get_sysattr_value(usb, "product"));
+			event.release_number = parseHex(udev_device_get_sysattr_value(usb, "bcdDevice"));
+		}
+		if (event.serial.empty())
+			event.serial = toString(udev_device_get_property_value(device, "ID_SERIAL_SHORT"));
+		return true;
+	}
+	void Udev::addPresentDevices()
+	{
+		// Devices connected before the monitor was started are recorded too, so their removal can be matched against the filter.
+		udev_enumerate *enumerate = udev_enumerate_new(m_udev);
+		if (!enumerate) return;
+		udev_enumerate_add_match_subsystem(enumerate, "hidraw");
+		udev_enumerate_scan_devices(enumerate);
+		for (udev_list_entry *entry = udev_enumerate_get_list_entry(enumerate); entry; entry = udev_list_entry_get_next(entry)){
+			udev_device *device = udev_device_new_from_syspath(m_udev, udev_list_entry_get_name(entry));
+			if (!device) continue;
+			const char *devnode = udev_device_get_devnode(device);
+			UdevEvent event;
+			if (devnode && readDevice(device, event)){
+				event.path = devnode;
+				m_devices[event.path] = event;
+			}
+			udev_device_unref(device);
+		}
+		udev_enumerate_unref(enumerate);
+	}
+	bool Udev::matchesFilter(const UdevEvent &event) const
+	{
+		uint32_t filter = m_filter;
+		return filter == 0 || ((static_cast<uint32_t>(event.vendor_id) << 16) | event.product_id) == filter;
+	}
+	bool Udev::toEvent(udev_device *device, UdevEvent &event)
+	{
+		const char *action = udev_device_get_action(device);
+		const char *devnode = udev_device_get_devnode(device);
+		if (!action || !devnode) return false;
+		event.path = devnode;
+		if (strcmp(action, "remove") == 0){
+			// Sysfs attributes of removed devices are not available any more and hidraw remove events usually have no ID properties, so the IDs and strings recorded when the device was added are reported.
+			auto known = m_devices.find(event.path);
+			if (known != m_devices.end()){
+				event = known->second;
+				m_devices.erase(known);
+			}else{
+				event.serial = toString(udev_device_get_property_value(device, "ID_SERIAL_SHORT"));
+				getIds(device, event.vendor_id, event.product_id);
+			}
+			event.action = UdevEvent::Action::remove;
+			return matchesFilter(event);
+		}
+		if (strcmp(action, "add") != 0) return false;
+		event.action = UdevEvent::Action::add;
+		if (!readDevice(device, event)) return false;
+		m_devices[event.path] = event;
+		return matchesFilter(event);
+	}
+	bool Udev::read(std::function<void(const UdevEvent &)> deviceCallback, int timeout_ms)
+	{
+		struct epoll_event events[4];
+		int count = epoll_wait(m_epoll_fd, events, 4, timeout_ms);
+		if (count < 0){
+			// Interrupted wait is not an error, the caller checks its exit condition and reads again.
+			return errno == EINTR;
+		}
+		for (int i = 0; i < count; i++){
+			for (auto &monitor: m_monitors){
+				if (events[i].data.fd == monitor->getEpollFd() && events[i].events & EPOLLIN){
+					udev_device *device = udev_monitor_receive_device(*monitor);
+					if (device){
+						UdevEvent event;
+						if (toEvent(device, event))
+							deviceCallback(event);
+						udev_device_unref(device);
+					}
+				}
+			}
+		}
+		return true;
+	}
+	bool Udev::interruptRead()
+	{
+		uint64_t value = 1;
+		ssize_t wrote = write(m_event_fd, &value, sizeof(value));
+		return (wrote == sizeof(value));
+	}
+	UdevMonitor::UdevMonitor()
+	{
+		m_monitor = nullptr;
+		m_monitor_fd = -1;
+	}
+	UdevMonitor::~UdevMonitor()
+	{
+		if (m_monitor)
+			udev_monitor_unref(m_monitor);
+	}
+	bool UdevMonitor::open(Udev &udev, const char *name)
+	{
+		m_monitor = udev_monitor_new_from_netlink(udev, name);
+		if (!m_monitor) {
+			return false;
+		}
+		udev_monitor_set_receive_buffer_size(m_monitor, 1024 * 1024);
+		if (udev_monitor_enable_receiving(m_monitor) < 0){
+			return false;
+		}
+		return true;
+	}
+	void UdevMonitor::close()
+	{
+		if (m_monitor)
+			udev_monitor_unref(m_monitor);
+		m_monitor = nullptr;
+	}
+	bool UdevMonitor::setupEpoll(int epoll_fd)
+	{
+		m_monitor_fd = udev_monitor_get_fd(m_monitor);
+		epoll_event ep_udev = {};
+		ep_udev.events = EPOLLIN;
+		ep_udev.data.fd = m_monitor_fd;
+		if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, m_monitor_fd, &ep_udev) < 0) {
+			return false;
+		}
+		return true;
+	}
+	bool UdevMonitor::setFilter()
+	{
+		// Only hidraw nodes are listed, events of other USB devices and interfaces are dropped by the socket filter.
+		if (udev_monitor_filter_add_match_subsystem_devtype(m_monitor, "hidraw", nullptr) < 0){
+			return false;
+		}
+		if (udev_monitor_filter_update(m_monitor) < 0){
+			return false;
+		}
+		return true;
+	}
+	int UdevMonitor::getEpollFd()
+	{
+		return m_monitor_fd;
+	}
+	UdevMonitor::operator udev_monitor*()
+	{
+		return m_monitor;
+	}
+}
+#endif
@@ -22,29 +22,53 @@ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
-#ifndef HEADER_GUI_UDEV_H_
-#define HEADER_GUI_UDEV_H_
+#ifndef HEADER_UDEV_H_
+#define HEADER_UDEV_H_
+#include <stdint.h>
+#include <string>
 #include <vector>
 #include <memory>
+#include <atomic>
 #include <functional>
+#include <unordered_map>
 struct udev;
+struct udev_device;
 struct udev_monitor;
-namespace gui
+namespace mcp2200
 {
 	struct UdevMonitor;
+	// Hotplug event of a hidraw device, IDs and strings are read from udev properties and sysfs attributes without opening the device.
+	struct UdevEvent
+	{
+		enum class Action
+		{
+			add,
+			remove,
+		};
+		Action action;
+		std::string path, serial, manufacturer, product;
+		uint16_t vendor_id, product_id, release_number;
+		UdevEvent();
+	};
 	struct Udev
 	{
 		Udev();
 		~Udev();
-		bool open();
+		bool open(bool kernel_events = false);
 		void close();
 		operator udev*();
-		bool read(std::function<void(const char *, const char *, const char *)> deviceCallback);
+		bool read(std::function<void(const UdevEvent &)> deviceCallback, int timeout_ms = -1);
 		bool interruptRead();
+		void setFilter(uint16_t vendor_id, uint16_t product_id);
 		private:
 		udev *m_udev;
 		int m_epoll_fd;
 		int m_event_fd;
+		std::atomic<uint32_t> m_filter;
+		std::unordered_map<std::string, UdevEvent> m_devices;
+		bool toEvent(udev_device *device, UdevEvent &event);
+		void addPresentDevices();
+		bool matchesFilter(const UdevEvent &event) const;
 		std::vector<std::unique_ptr<UdevMonitor>> m_monitors;
 		Udev(Udev const &) = delete;
 		void operator=(Udev const &x) = delete;
@@ -66,4 +90,4 @@ namespace gui
 		void operator=(UdevMonitor const &x) = delete;
 	};
 }
-#endif /* HEADER_GUI_UDEV_H_ */
+#endif /* HEADER_UDEV_H_ */
@@ -26,6 +26,10 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 namespace po = boost::program_options;
 namespace command_line
 {
+	VendorProduct::VendorProduct():
+		m_ids_set(false)
+	{
+	}
 	void VendorProduct::addOptions(boost::program_options::options_description &options, boost::program_options::options_description &)
 	{
 		options.add_options()
@@ -33,8 +37,9 @@ namespace command_line
 			("product,P", po::value<HexOption<uint16_t>>(&m_product_id)->default_value(HexOption<uint16_t>(0x00df), "00df"), "device product ID")
 			;
 	}
-	bool VendorProduct::checkOptions(po::variables_map &)
+	bool VendorProduct::checkOptions(po::variables_map &variable_map)
 	{
+		m_ids_set = !variable_map["vendor"].defaulted() || !variable_map["product"].defaulted();
 		return true;
 	}
 	const uint16_t& VendorProduct::getVendorId() const
@@ -45,4 +50,8 @@ namespace command_line
 	{
 		return m_product_id;
 	}
+	bool VendorProduct::areIdsSet() const
+	{
+		return m_ids_set;
+	}
 }
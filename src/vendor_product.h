@@ -31,12 +31,15 @@ namespace command_line
 {
 	struct VendorProduct
 	{
+		VendorProduct();
 		void addOptions(boost::program_options::options_description &options, boost::program_options::options_description &hidden_options);
 		bool checkOptions(boost::program_options::variables_map &variable_map);
 		const uint16_t& getVendorId() const;
 		const uint16_t& getProductId() const;
+		bool areIdsSet() const;
 		private:
 		HexOption<uint16_t> m_vendor_id, m_product_id;
+		bool m_ids_set;
 	};
 }
 #endif /* VENDOR_PRODUCT_H_ */
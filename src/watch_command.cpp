@@ -0,0 +1,117 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "watch_command.h"
+#include "mcp2200.h"
+#include <iostream>
+#include <chrono>
+#include <thread>
+#include <csignal>
+using namespace std;
+namespace po = boost::program_options;
+namespace command_line
+{
+	static volatile sig_atomic_t interrupted = 0;
+	static void onInterrupt(int)
+	{
+		interrupted = 1;
+	}
+	WatchCommand::WatchCommand():
+		DeviceCommand("watch", "print GPIO state whenever it changes"),
+		m_mask(0xff),
+		m_format(SampleFormat::text),
+		m_interval(0),
+		m_count(0)
+	{
+	}
+	WatchCommand::~WatchCommand()
+	{
+	}
+	void WatchCommand::addOptions(po::options_description &options, po::options_description &hidden_options)
+	{
+		using namespace boost::program_options;
+		DeviceCommand::addOptions(options, hidden_options);
+		options.add_options()
+			("interval,i", po::value<int>(&m_interval)->default_value(10)->notifier([](int value){ if (value < 0) throw validation_error(validation_error::invalid_option_value, "interval", to_string(value)); }), "sampling interval in milliseconds (0 samples as fast as possible)")
+			("mask,m", po::value<BitMap<uint8_t>>(&m_mask)->default_value(BitMap<uint8_t>(0xff), "11111111"), "GPIO pins to watch")
+			("format,f", po::value<SampleFormat>(&m_format)->default_value(SampleFormat::text), "output format (text, csv, ndjson or binary)")
+			("count,n", po::value<size_t>(&m_count)->default_value(0), "exit after printing this many samples (0 for no limit)")
+		;
+	}
+	bool WatchCommand::checkOptions(po::variables_map &variable_map)
+	{
+		return DeviceCommand::checkOptions(variable_map);
+	}
+	bool WatchCommand::run(mcp2200::Device &device)
+	{
+		using clock = chrono::steady_clock;
+		const auto flush_interval = chrono::milliseconds(100);
+		const auto interval = chrono::milliseconds(m_interval);
+		SampleWriter writer(m_format);
+		mcp2200::Command response;
+		uint8_t mask = m_mask, last_value = 0;
+		size_t printed = 0;
+		bool first = true, result = true;
+		interrupted = 0;
+		auto previous_handler = signal(SIGINT, onInterrupt);
+		auto start = clock::now(), next_sample = start, last_flush = start;
+		while (!interrupted && (m_count == 0 || printed < m_count)){
+			if (!device.readAll(response)){
+				cerr << "could not read GPIO values\n";
+				result = false;
+				break;
+			}
+			auto now = clock::now();
+			uint8_t value = response.getGpioValues() & mask;
+			if (first || value != last_value){
+				writer.write(chrono::duration_cast<chrono::microseconds>(now - start).count(), value);
+				last_value = value;
+				first = false;
+				printed++;
+			}
+			if (writer.isFull() || (!writer.isEmpty() && now - last_flush >= flush_interval)){
+				if (!writer.flush(stdout)){
+					cerr << "could not write output\n";
+					result = false;
+					break;
+				}
+				last_flush = now;
+			}
+			if (m_interval > 0){
+				next_sample += interval;
+				if (next_sample > now){
+					this_thread::sleep_until(next_sample);
+				}else{
+					next_sample = now;
+				}
+			}
+		}
+		if (!writer.flush(stdout) && result){
+			cerr << "could not write output\n";
+			result = false;
+		}
+		signal(SIGINT, previous_handler);
+		return result;
+	}
+}
@@ -0,0 +1,95 @@
+/*
+Copyright (c) 2026, Albertas Vyšniauskas
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+1. Redistributions of source code must retain the above copyright notice, this
+   list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#include "worker.h"
+using namespace std;
+namespace mcp2200
+{
+	Worker::Worker():
+		m_running(0),
+		m_stop(false)
+	{
+	}
+	Worker::~Worker()
+	{
+		stop();
+	}
+	void Worker::start(size_t threads)
+	{
+		if (!m_threads.empty()) return;
+		m_stop = false;
+		for (size_t i = 0; i < threads; i++)
+			m_threads.emplace_back(&Worker::run, this);
+	}
+	void Worker::stop()
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stop = true;
+			m_jobs.clear();
+		}
+		m_condition.notify_all();
+		for (auto &thread: m_threads)
+			thread.join();
+		m_threads.clear();
+	}
+	bool Worker::post(function<void()> job)
+	{
+		{
+			lock_guard<mutex> lock(m_mutex);
+			if (m_stop) return false;
+			m_jobs.push_back(move(job));
+		}
+		m_condition.notify_one();
+		return true;
+	}
+	size_t Worker::getPending()
+	{
+		lock_guard<mutex> lock(m_mutex);
+		return m_jobs.size() + m_running;
+	}
+	bool Worker::isWorkerThread() const
+	{
+		for (auto &thread: m_threads){
+			if (thread.get_id() == this_thread::get_id())
+				return true;
+		}
+		return false;
+	}
+	void Worker::run()
+	{
+		unique_lock<mutex> lock(m_mutex);
+		for (;;){
+			m_condition.wait(lock, [this]{ return m_stop || !m_jobs.empty(); });
+			if (m_stop) break;
+			auto job = move(m_jobs.front());
+			m_jobs.pop_front();
+			m_running++;
+			lock.unlock();
+			job();
+			lock.lock();
+			m_running--;
+		}
+	}
+}